@@ -76,6 +76,7 @@ func buildApplication(f *flags.Build) error {
 		IgnoreFrontend:    f.SkipFrontend,
 		Compress:          f.Upx,
 		CompressFlags:     f.UpxFlags,
+		CompressAssets:    f.CompressAssets,
 		UserTags:          f.GetTags(),
 		WebView2Strategy:  f.GetWebView2Strategy(),
 		TrimPath:          f.TrimPath,
@@ -102,6 +103,7 @@ func buildApplication(f *flags.Build) error {
 	tableData = append(tableData, pterm.TableData{
 		{"Skip Frontend", bool2Str(f.SkipFrontend)},
 		{"Compress", bool2Str(f.Upx)},
+		{"Compress Assets", bool2Str(f.CompressAssets)},
 		{"Package", bool2Str(!f.NoPackage)},
 		{"Clean Bin Dir", bool2Str(f.Clean)},
 		{"LDFlags", f.LdFlags},
@@ -27,6 +27,7 @@ type Build struct {
 	NoPackage               bool   `description:"Skips platform specific packaging"`
 	Upx                     bool   `description:"Compress final binary with UPX (if installed)"`
 	UpxFlags                string `description:"Flags to pass to upx"`
+	CompressAssets          bool   `description:"Embed brotli (if installed) and gzip variants of the frontend assets"`
 	Platform                string `description:"Platform to target. Comma separate multiple platforms"`
 	OutputFilename          string `name:"o" description:"Output filename"`
 	Clean                   bool   `description:"Clean the bin directory before building"`
@@ -7,12 +7,15 @@ import (
 
 	"github.com/wailsapp/wails/v2/internal/binding"
 	"github.com/wailsapp/wails/v2/internal/logger"
+	"github.com/wailsapp/wails/v2/pkg/assetserver"
 )
 
 const expectedPromiseBindings = `// Cynhyrchwyd y ffeil hon yn awtomatig. PEIDIWCH Â MODIWL
 // This file is automatically generated. DO NOT EDIT
 import {binding_test} from '../models';
 
+export function BlobReturn(arg1:string):Promise<ArrayBuffer>;
+
 export function ErrorReturn(arg1:number):Promise<void>;
 
 export function NoReturn(arg1:string):Promise<void>;
@@ -50,8 +53,9 @@ func (h *PromisesTest) SingleReturnStructSlice(_ interface{}) []PromisesTestRetu
 func (h *PromisesTest) SingleReturnStructPointerSlice(_ interface{}) []*PromisesTestReturnStruct {
 	return []*PromisesTestReturnStruct{}
 }
-func (h *PromisesTest) SingleReturnWithError(_ int) (string, error) { return "", nil }
-func (h *PromisesTest) TwoReturn(_ interface{}) (string, int)       { return "", 0 }
+func (h *PromisesTest) BlobReturn(_ string) (*assetserver.Blob, error) { return nil, nil }
+func (h *PromisesTest) SingleReturnWithError(_ int) (string, error)    { return "", nil }
+func (h *PromisesTest) TwoReturn(_ interface{}) (string, int)          { return "", 0 }
 
 func TestPromises(t *testing.T) {
 	// given
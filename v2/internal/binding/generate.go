@@ -107,12 +107,10 @@ func (b *Bindings) GenerateGoBindings(baseDir string) error {
 				} else if methodDetails.OutputCount() == 1 && methodDetails.Outputs[0].TypeName == "error" {
 					returnType = "Promise<void>"
 				} else {
-					outputTypeName := entityFullReturnType(methodDetails.Outputs[0].TypeName, b.tsPrefix, b.tsSuffix, &importNamespaces)
-					firstType := goTypeToTypescriptType(outputTypeName, &importNamespaces)
+					firstType := b.outputToTypescriptType(methodDetails.Outputs[0], &importNamespaces)
 					returnType = "Promise<" + firstType
 					if methodDetails.OutputCount() == 2 && methodDetails.Outputs[1].TypeName != "error" {
-						outputTypeName = entityFullReturnType(methodDetails.Outputs[1].TypeName, b.tsPrefix, b.tsSuffix, &importNamespaces)
-						secondType := goTypeToTypescriptType(outputTypeName, &importNamespaces)
+						secondType := b.outputToTypescriptType(methodDetails.Outputs[1], &importNamespaces)
 						returnType += "|" + secondType
 					}
 					returnType += ">"
@@ -227,6 +225,15 @@ func goTypeToTypescriptType(input string, importNamespaces *slicer.StringSlicer)
 	return goTypeToJSDocType(input, importNamespaces)
 }
 
+// outputToTypescriptType returns the Typescript type of a method result, binary results resolve with an ArrayBuffer
+func (b *Bindings) outputToTypescriptType(output *Parameter, importNamespaces *slicer.StringSlicer) string {
+	if output.IsBlob() {
+		return "ArrayBuffer"
+	}
+	outputTypeName := entityFullReturnType(output.TypeName, b.tsPrefix, b.tsSuffix, importNamespaces)
+	return goTypeToTypescriptType(outputTypeName, importNamespaces)
+}
+
 func entityFullReturnType(input, prefix, suffix string, importNamespaces *slicer.StringSlicer) string {
 	if strings.ContainsRune(input, '.') {
 		nameSpace, returnType := getSplitReturn(input)
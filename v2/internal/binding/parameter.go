@@ -1,6 +1,13 @@
 package binding
 
-import "reflect"
+import (
+	"reflect"
+
+	"github.com/wailsapp/wails/v2/pkg/assetserver"
+)
+
+// blobType is the type of binary results, the runtime resolves them with an ArrayBuffer
+var blobType = reflect.TypeOf((*assetserver.Blob)(nil))
 
 // Parameter defines a Go method parameter
 type Parameter struct {
@@ -26,3 +33,8 @@ func (p *Parameter) IsType(typename string) bool {
 func (p *Parameter) IsError() bool {
 	return p.IsType("error")
 }
+
+// IsBlob returns true if the parameter is a binary result
+func (p *Parameter) IsBlob() bool {
+	return p.IsType(blobType.String())
+}
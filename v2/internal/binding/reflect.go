@@ -122,6 +122,12 @@ func (b *Bindings) getMethods(value interface{}) ([]*BoundMethod, error) {
 
 			thisOutput := output
 
+			// Binary results don't have a model
+			if thisParam.IsBlob() {
+				outputs = append(outputs, thisParam)
+				continue
+			}
+
 			if thisOutput.Kind() == reflect.Slice {
 				thisOutput = thisOutput.Elem()
 			}
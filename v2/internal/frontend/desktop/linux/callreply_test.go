@@ -0,0 +1,151 @@
+//go:build linux
+
+package linux
+
+import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"net/url"
+	"os"
+	"runtime"
+	"sync"
+	"testing"
+
+	"github.com/wailsapp/wails/v2/internal/frontend"
+	"github.com/wailsapp/wails/v2/internal/frontend/dispatcher"
+	wailsruntime "github.com/wailsapp/wails/v2/internal/frontend/runtime"
+	"github.com/wailsapp/wails/v2/internal/logger"
+	"github.com/wailsapp/wails/v2/pkg/options"
+)
+
+const benchCallJS = `
+window.benchRun = async (n, withReply) => {
+	const reply = window.WailsInvokeWithReply;
+	if (!withReply) {
+		window.WailsInvokeWithReply = undefined;
+	}
+	for (let i = 0; i < n; i++) {
+		await window.ObfuscatedCall(0, ["ping"]);
+	}
+	window.WailsInvokeWithReply = reply;
+	window.WailsInvoke("bench:done");
+};
+`
+
+// benchDispatcher answers every call with a small result, like a bound method that returns a string
+type benchDispatcher struct {
+	done chan struct{}
+}
+
+func (d *benchDispatcher) ProcessMessage(message string, _ frontend.Frontend) (string, error) {
+	if message == "bench:done" {
+		d.done <- struct{}{}
+		return "", nil
+	}
+
+	if message[0] != 'c' {
+		return "", nil
+	}
+
+	var payload struct {
+		CallbackID string `json:"callbackID"`
+	}
+	if err := json.Unmarshal([]byte(message[1:]), &payload); err != nil {
+		return "", err
+	}
+
+	result, err := json.Marshal(&dispatcher.CallbackMessage{CallbackID: payload.CallbackID, Result: "pong"})
+	return "c" + string(result), err
+}
+
+var (
+	benchFrontendOnce sync.Once
+	benchFrontend     *Frontend
+	benchFrontendErr  error
+	benchDispatch     = &benchDispatcher{done: make(chan struct{})}
+)
+
+// setupBenchFrontend starts GTK on a dedicated thread and opens a window with the desktop runtime loaded
+func setupBenchFrontend() (*Frontend, error) {
+	benchFrontendOnce.Do(func() {
+		if os.Getenv("DISPLAY") == "" && os.Getenv("WAYLAND_DISPLAY") == "" {
+			benchFrontendErr = fmt.Errorf("no display available")
+			return
+		}
+
+		initErr := make(chan error)
+		go func() {
+			runtime.LockOSThread()
+			if err := initGTK(); err != nil {
+				initErr <- err
+				return
+			}
+			initErr <- nil
+			(&Frontend{}).RunMainLoop()
+		}()
+		if benchFrontendErr = <-initErr; benchFrontendErr != nil {
+			return
+		}
+
+		domReady := make(chan struct{})
+		appoptions := &options.App{
+			Width:            800,
+			Height:           600,
+			BackgroundColour: &options.RGBA{R: 255, G: 255, B: 255, A: 255},
+			OnDomReady:       func(_ context.Context) { close(domReady) },
+		}
+
+		f := &Frontend{
+			ctx:             context.Background(),
+			frontendOptions: appoptions,
+			logger:          logger.New(nil),
+			dispatcher:      benchDispatch,
+		}
+
+		var wg sync.WaitGroup
+		wg.Add(1)
+		invokeOnMainThread(func() {
+			f.mainWindow = NewWindow(appoptions, false, false)
+			f.mainWindow.Run("data:text/html," + url.PathEscape("<html><head></head><body></body></html>"))
+			wg.Done()
+		})
+		wg.Wait()
+
+		go f.startMessageProcessor()
+		<-domReady
+
+		f.ExecJS(string(wailsruntime.DesktopIPC))
+		f.ExecJS(string(wailsruntime.RuntimeDesktopJS))
+		f.ExecJS(benchCallJS)
+		benchFrontend = f
+	})
+	return benchFrontend, benchFrontendErr
+}
+
+func benchmarkCallRoundTrip(b *testing.B, withReply bool) {
+	f, err := setupBenchFrontend()
+	if err != nil {
+		b.Skip(err)
+	}
+
+	if withReply && !f.mainWindow.invokeWithReply {
+		b.Skip("script message replies need the webkit2_40 or webkit2_41 build tag and WebKit2GTK 2.40+")
+	}
+
+	b.ResetTimer()
+	f.ExecJS(fmt.Sprintf("window.benchRun(%d, %t);", b.N, withReply))
+	<-benchDispatch.done
+}
+
+// BenchmarkCallRoundTripExecJS measures the round-trip of a bound method call, where the result is delivered by
+// evaluating a `window.wails.Callback(...)` script.
+func BenchmarkCallRoundTripExecJS(b *testing.B) {
+	benchmarkCallRoundTrip(b, false)
+}
+
+// BenchmarkCallRoundTripReply measures the round-trip of a bound method call, where the result is delivered with the
+// reply of the script message.
+func BenchmarkCallRoundTripReply(b *testing.B) {
+	benchmarkCallRoundTrip(b, true)
+}
@@ -0,0 +1,122 @@
+#include <string.h>
+#include "clipboard.h"
+
+// The clipboard never waits for the owner of the selection. Requests are answered through callbacks on the main loop
+// and the content we own is only serialised once somebody pastes it.
+
+extern void clipboardReceived(guintptr request, void *data, int length);
+extern void clipboardProvide(GtkSelectionData *selection, guint info, guintptr content);
+extern void clipboardRelease(guintptr content);
+
+static GtkClipboard *getClipboard(int primary)
+{
+    return gtk_clipboard_get(primary ? GDK_SELECTION_PRIMARY : GDK_SELECTION_CLIPBOARD);
+}
+
+static void textReceived(GtkClipboard *clipboard, const gchar *text, gpointer data)
+{
+    clipboardReceived((guintptr)data, (void *)text, text != NULL ? strlen(text) : -1);
+}
+
+static void imageReceived(GtkClipboard *clipboard, GdkPixbuf *pixbuf, gpointer data)
+{
+    gchar *buffer = NULL;
+    gsize size = 0;
+    if (pixbuf == NULL || !gdk_pixbuf_save_to_buffer(pixbuf, &buffer, &size, "png", NULL, NULL))
+    {
+        clipboardReceived((guintptr)data, NULL, -1);
+        return;
+    }
+    clipboardReceived((guintptr)data, buffer, size);
+    g_free(buffer);
+}
+
+static void contentsReceived(GtkClipboard *clipboard, GtkSelectionData *selection, gpointer data)
+{
+    // The length is -1 if the owner doesn't provide the target
+    clipboardReceived((guintptr)data, (void *)gtk_selection_data_get_data(selection), gtk_selection_data_get_length(selection));
+}
+
+void ClipboardRequest(char *mimeType, guintptr request)
+{
+    GtkClipboard *clipboard = getClipboard(FALSE);
+    if (strcmp(mimeType, CLIPBOARD_TEXT) == 0)
+    {
+        gtk_clipboard_request_text(clipboard, textReceived, (gpointer)request);
+    }
+    else if (strcmp(mimeType, CLIPBOARD_IMAGE) == 0)
+    {
+        gtk_clipboard_request_image(clipboard, imageReceived, (gpointer)request);
+    }
+    else
+    {
+        gtk_clipboard_request_contents(clipboard, gdk_atom_intern(mimeType, FALSE), contentsReceived, (gpointer)request);
+    }
+}
+
+static void provideContent(GtkClipboard *clipboard, GtkSelectionData *selection, guint info, gpointer data)
+{
+    clipboardProvide(selection, info, (guintptr)data);
+}
+
+static void releaseContent(GtkClipboard *clipboard, gpointer data)
+{
+    clipboardRelease((guintptr)data);
+}
+
+// The info of every target is the index of its MIME type
+gboolean ClipboardSet(int primary, char **mimeTypes, int count, guintptr content)
+{
+    GtkTargetList *list = gtk_target_list_new(NULL, 0);
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(mimeTypes[i], CLIPBOARD_TEXT) == 0)
+        {
+            gtk_target_list_add_text_targets(list, i);
+        }
+        else if (strcmp(mimeTypes[i], CLIPBOARD_IMAGE) == 0)
+        {
+            gtk_target_list_add_image_targets(list, i, TRUE);
+        }
+        else
+        {
+            gtk_target_list_add(list, gdk_atom_intern(mimeTypes[i], FALSE), 0, i);
+        }
+    }
+
+    gint targetCount = 0;
+    GtkTargetEntry *targets = gtk_target_table_new_from_list(list, &targetCount);
+    gboolean result = gtk_clipboard_set_with_data(getClipboard(primary), targets, targetCount, provideContent, releaseContent, (gpointer)content);
+    gtk_target_table_free(targets, targetCount);
+    gtk_target_list_unref(list);
+    return result;
+}
+
+void ClipboardSetSelectionData(GtkSelectionData *selection, char *mimeType, void *data, int length)
+{
+    if (strcmp(mimeType, CLIPBOARD_TEXT) == 0)
+    {
+        gtk_selection_data_set_text(selection, data != NULL ? data : "", length);
+        return;
+    }
+
+    GdkAtom target = gtk_selection_data_get_target(selection);
+    if (strcmp(mimeType, CLIPBOARD_IMAGE) == 0 && target != gdk_atom_intern_static_string(CLIPBOARD_IMAGE))
+    {
+        // Convert the PNG to the requested image format
+        GdkPixbufLoader *loader = gdk_pixbuf_loader_new_with_type("png", NULL);
+        if (loader == NULL)
+        {
+            return;
+        }
+        gboolean written = gdk_pixbuf_loader_write(loader, data, length, NULL);
+        if (gdk_pixbuf_loader_close(loader, NULL) && written)
+        {
+            gtk_selection_data_set_pixbuf(selection, gdk_pixbuf_loader_get_pixbuf(loader));
+        }
+        g_object_unref(loader);
+        return;
+    }
+
+    gtk_selection_data_set(selection, target, 8, data, length);
+}
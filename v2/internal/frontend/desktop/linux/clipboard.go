@@ -5,47 +5,161 @@ package linux
 
 /*
 #cgo linux pkg-config: gtk+-3.0
-#cgo !webkit2_41 pkg-config: webkit2gtk-4.0
-#cgo webkit2_41 pkg-config: webkit2gtk-4.1
 
+#include <stdlib.h>
 #include "gtk/gtk.h"
-#include "webkit2/webkit2.h"
+#include "clipboard.h"
+*/
+import "C"
+import (
+	"errors"
+	"runtime/cgo"
+	"sync"
+	"sync/atomic"
+	"unsafe"
+)
 
-static gchar* GetClipboardText() {
-	GtkClipboard *clip = gtk_clipboard_get(GDK_SELECTION_CLIPBOARD);
-	return gtk_clipboard_wait_for_text(clip);
-}
+// clipboardText is converted by GTK to all text formats, see clipboard.h
+const clipboardText = "text/plain;charset=utf-8"
+
+// errClipboardOnMainThread is returned if the clipboard is read on the main thread. The owner answers asynchronously
+// through the main loop, waiting for it would need a nested main loop that dispatches other events out of order.
+var errClipboardOnMainThread = errors.New("the clipboard can't be read on the main thread, read it from a goroutine")
+
+// clipboardContent is the content we own on a selection. It's serialised lazily, once per MIME type, when
+// somebody pastes it.
+type clipboardContent struct {
+	mimeTypes  []string
+	cMimeTypes []*C.char
+	provide    func(mimeType string) []byte
 
-static void SetClipboardText(gchar* text) {
-	GtkClipboard *clip = gtk_clipboard_get(GDK_SELECTION_CLIPBOARD);
-	gtk_clipboard_set_text(clip, text, -1);
+	mu    sync.Mutex
+	cache map[string][]byte
 
-	clip = gtk_clipboard_get(GDK_SELECTION_PRIMARY);
-	gtk_clipboard_set_text(clip, text, -1);
+	// refs is the number of selections that hold the content
+	refs int32
+}
+
+func (c *clipboardContent) data(mimeType string) []byte {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if data, ok := c.cache[mimeType]; ok {
+		return data
+	}
+	data := c.provide(mimeType)
+	c.cache[mimeType] = data
+	return data
 }
-*/
-import "C"
-import "sync"
 
 func (f *Frontend) ClipboardGetText() (string, error) {
-	var text string
-	var wg sync.WaitGroup
-	wg.Add(1)
+	text, err := clipboardRequest(clipboardText)
+	return string(text), err
+}
+
+func (f *Frontend) ClipboardSetText(text string) error {
+	// The text is shared by CLIPBOARD and PRIMARY and only converted once it's pasted
+	clipboardSet([]string{clipboardText}, func(string) []byte { return []byte(text) }, true)
+	return nil
+}
+
+// ClipboardGetData returns the clipboard content of the given MIME type, nil if there's no content of that type.
+// Images can be requested as `image/png` regardless of the format the owner provides, text as
+// `text/plain;charset=utf-8`.
+func (f *Frontend) ClipboardGetData(mimeType string) ([]byte, error) {
+	return clipboardRequest(mimeType)
+}
+
+// ClipboardSetData offers the MIME types on the clipboard. provide is called on the main thread the first time a
+// MIME type gets pasted and should return quickly. Content offered as `image/png` can be pasted in all image formats.
+func (f *Frontend) ClipboardSetData(mimeTypes []string, provide func(mimeType string) []byte) error {
+	clipboardSet(mimeTypes, provide, false)
+	return nil
+}
+
+// clipboardRequest requests the content from the owner of the clipboard and waits for it, nil if there's no content of
+// the MIME type. It must not be called on the main thread, which receives the content.
+func clipboardRequest(mimeType string) ([]byte, error) {
+	if isMainThread() {
+		return nil, errClipboardOnMainThread
+	}
+
+	result := make(chan []byte, 1)
+	request := cgo.NewHandle(func(data []byte, ok bool) {
+		result <- data
+	})
+
 	invokeOnMainThread(func() {
-		ctxt := C.GetClipboardText()
-		defer C.g_free(C.gpointer(ctxt))
-		text = C.GoString(ctxt)
-		wg.Done()
+		cMimeType := C.CString(mimeType)
+		defer C.free(unsafe.Pointer(cMimeType))
+		C.ClipboardRequest(cMimeType, C.guintptr(request))
 	})
-	wg.Wait()
-	return text, nil
+	return <-result, nil
 }
 
-func (f *Frontend) ClipboardSetText(text string) error {
+func clipboardSet(mimeTypes []string, provide func(mimeType string) []byte, primary bool) {
+	content := &clipboardContent{
+		mimeTypes: mimeTypes,
+		provide:   provide,
+		cache:     make(map[string][]byte, len(mimeTypes)),
+	}
+
 	invokeOnMainThread(func() {
-		ctxt := (*C.gchar)(C.CString(text))
-		defer C.g_free(C.gpointer(ctxt))
-		C.SetClipboardText(ctxt)
+		content.cMimeTypes = make([]*C.char, len(mimeTypes))
+		cArray := C.malloc(C.size_t(len(mimeTypes)) * C.size_t(unsafe.Sizeof(uintptr(0))))
+		defer C.free(cArray)
+		for i, mimeType := range mimeTypes {
+			content.cMimeTypes[i] = C.CString(mimeType)
+		}
+		copy(unsafe.Slice((**C.char)(cArray), len(mimeTypes)), content.cMimeTypes)
+
+		handle := cgo.NewHandle(content)
+		selections := []C.int{0}
+		if primary {
+			selections = append(selections, 1)
+		}
+		content.refs = int32(len(selections))
+		for _, selection := range selections {
+			if C.ClipboardSet(selection, (**C.char)(cArray), C.int(len(mimeTypes)), C.guintptr(handle)) == 0 {
+				clipboardRelease(C.guintptr(handle))
+			}
+		}
 	})
-	return nil
+}
+
+//export clipboardReceived
+func clipboardReceived(request C.guintptr, data unsafe.Pointer, length C.int) {
+	handle := cgo.Handle(request)
+	defer handle.Delete()
+
+	if length < 0 {
+		handle.Value().(func([]byte, bool))(nil, false)
+		return
+	}
+	handle.Value().(func([]byte, bool))(C.GoBytes(data, length), true)
+}
+
+//export clipboardProvide
+func clipboardProvide(selection *C.GtkSelectionData, info C.guint, handle C.guintptr) {
+	content := cgo.Handle(handle).Value().(*clipboardContent)
+	data := content.data(content.mimeTypes[info])
+
+	var ptr unsafe.Pointer
+	if len(data) > 0 {
+		ptr = unsafe.Pointer(&data[0])
+	}
+	C.ClipboardSetSelectionData(selection, content.cMimeTypes[info], ptr, C.int(len(data)))
+}
+
+//export clipboardRelease
+func clipboardRelease(handle C.guintptr) {
+	h := cgo.Handle(handle)
+	content := h.Value().(*clipboardContent)
+	if atomic.AddInt32(&content.refs, -1) > 0 {
+		return
+	}
+
+	for _, cMimeType := range content.cMimeTypes {
+		C.free(unsafe.Pointer(cMimeType))
+	}
+	h.Delete()
 }
@@ -0,0 +1,15 @@
+#ifndef clipboard_h
+#define clipboard_h
+
+#include <gtk/gtk.h>
+
+// MIME types that are converted by GTK, text is offered and requested in all text formats and PNG images in all
+// image formats supported by GdkPixbuf
+#define CLIPBOARD_TEXT "text/plain;charset=utf-8"
+#define CLIPBOARD_IMAGE "image/png"
+
+void ClipboardRequest(char *mimeType, guintptr request);
+gboolean ClipboardSet(int primary, char **mimeTypes, int count, guintptr content);
+void ClipboardSetSelectionData(GtkSelectionData *selection, char *mimeType, void *data, int length);
+
+#endif /* clipboard_h */
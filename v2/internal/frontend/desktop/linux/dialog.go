@@ -4,8 +4,10 @@
 package linux
 
 import (
-	"github.com/wailsapp/wails/v2/internal/frontend"
+	"sync"
 	"unsafe"
+
+	"github.com/wailsapp/wails/v2/internal/frontend"
 )
 
 /*
@@ -20,12 +22,42 @@ const (
 	GTK_FILE_CHOOSER_ACTION_SELECT_FOLDER C.GtkFileChooserAction = C.GTK_FILE_CHOOSER_ACTION_SELECT_FOLDER
 )
 
-var openFileResults = make(chan []string)
-var messageDialogResult = make(chan string)
+// dialogResults hands the result of a dialog to the goroutine waiting for it. Every request has its own result
+// channel, so any number of dialogs can be open at the same time.
+type dialogResults[T any] struct {
+	mu      sync.Mutex
+	next    uintptr
+	pending map[uintptr]chan T
+}
+
+func (d *dialogResults[T]) add() (uintptr, <-chan T) {
+	d.mu.Lock()
+	defer d.mu.Unlock()
+	if d.pending == nil {
+		d.pending = make(map[uintptr]chan T)
+	}
+	d.next++
+	// Buffered, so resolving never blocks the main thread
+	result := make(chan T, 1)
+	d.pending[d.next] = result
+	return d.next, result
+}
+
+func (d *dialogResults[T]) resolve(requestID uintptr, result T) {
+	d.mu.Lock()
+	pending, ok := d.pending[requestID]
+	delete(d.pending, requestID)
+	d.mu.Unlock()
+	if ok {
+		pending <- result
+	}
+}
+
+var openFileResults dialogResults[[]string]
+var messageDialogResults dialogResults[string]
 
 func (f *Frontend) OpenFileDialog(dialogOptions frontend.OpenDialogOptions) (result string, err error) {
-	f.mainWindow.OpenFileDialog(dialogOptions, 0, GTK_FILE_CHOOSER_ACTION_OPEN)
-	results := <-openFileResults
+	results := <-f.mainWindow.OpenFileDialog(dialogOptions, 0, GTK_FILE_CHOOSER_ACTION_OPEN)
 	if len(results) == 1 {
 		return results[0], nil
 	}
@@ -33,14 +65,12 @@ func (f *Frontend) OpenFileDialog(dialogOptions frontend.OpenDialogOptions) (res
 }
 
 func (f *Frontend) OpenMultipleFilesDialog(dialogOptions frontend.OpenDialogOptions) ([]string, error) {
-	f.mainWindow.OpenFileDialog(dialogOptions, 1, GTK_FILE_CHOOSER_ACTION_OPEN)
-	result := <-openFileResults
+	result := <-f.mainWindow.OpenFileDialog(dialogOptions, 1, GTK_FILE_CHOOSER_ACTION_OPEN)
 	return result, nil
 }
 
 func (f *Frontend) OpenDirectoryDialog(dialogOptions frontend.OpenDialogOptions) (string, error) {
-	f.mainWindow.OpenFileDialog(dialogOptions, 0, GTK_FILE_CHOOSER_ACTION_SELECT_FOLDER)
-	result := <-openFileResults
+	result := <-f.mainWindow.OpenFileDialog(dialogOptions, 0, GTK_FILE_CHOOSER_ACTION_SELECT_FOLDER)
 	if len(result) == 1 {
 		return result[0], nil
 	}
@@ -56,8 +86,7 @@ func (f *Frontend) SaveFileDialog(dialogOptions frontend.SaveDialogOptions) (str
 		ShowHiddenFiles:      dialogOptions.ShowHiddenFiles,
 		CanCreateDirectories: dialogOptions.CanCreateDirectories,
 	}
-	f.mainWindow.OpenFileDialog(options, 0, GTK_FILE_CHOOSER_ACTION_SAVE)
-	results := <-openFileResults
+	results := <-f.mainWindow.OpenFileDialog(options, 0, GTK_FILE_CHOOSER_ACTION_SAVE)
 	if len(results) == 1 {
 		return results[0], nil
 	}
@@ -65,25 +94,22 @@ func (f *Frontend) SaveFileDialog(dialogOptions frontend.SaveDialogOptions) (str
 }
 
 func (f *Frontend) MessageDialog(dialogOptions frontend.MessageDialogOptions) (string, error) {
-	f.mainWindow.MessageDialog(dialogOptions)
-	return <-messageDialogResult, nil
+	return <-f.mainWindow.MessageDialog(dialogOptions), nil
 }
 
 //export processOpenFileResult
-func processOpenFileResult(carray **C.char) {
-	// Create a Go slice from the C array
+func processOpenFileResult(requestID C.guintptr, carray **C.char, count C.int) {
 	var result []string
-	goArray := (*[1024]*C.char)(unsafe.Pointer(carray))[:1024:1024]
-	for _, s := range goArray {
-		if s == nil {
-			break
+	if count > 0 {
+		result = make([]string, 0, int(count))
+		for _, s := range unsafe.Slice(carray, int(count)) {
+			result = append(result, C.GoString(s))
 		}
-		result = append(result, C.GoString(s))
 	}
-	openFileResults <- result
+	openFileResults.resolve(uintptr(requestID), result)
 }
 
 //export processMessageDialogResult
-func processMessageDialogResult(result *C.char) {
-	messageDialogResult <- C.GoString(result)
+func processMessageDialogResult(requestID C.guintptr, result *C.char) {
+	messageDialogResults.resolve(uintptr(requestID), C.GoString(result))
 }
@@ -82,12 +82,15 @@ import (
 	"fmt"
 	"log"
 	"net"
+	"net/http"
 	"net/url"
 	"os"
 	"runtime"
 	"strings"
 	"sync"
+	"sync/atomic"
 	"text/template"
+	"time"
 	"unsafe"
 
 	"github.com/wailsapp/wails/v2/pkg/assetserver"
@@ -116,8 +119,8 @@ type Frontend struct {
 	debug           bool
 	devtoolsEnabled bool
 
-	// Assets
-	assets   *assetserver.AssetServer
+	// Assets, the asset server is published by the startup goroutine once it's ready
+	assets   atomic.Pointer[assetserver.AssetServer]
 	startURL *url.URL
 
 	// main window handle
@@ -135,19 +138,24 @@ func (f *Frontend) WindowClose() {
 }
 
 func NewFrontend(ctx context.Context, appoptions *options.App, myLogger *logger.Logger, appBindings *binding.Bindings, dispatcher frontend.Dispatcher) *Frontend {
+	startupTrace.add("main", startupTrace.start, time.Now())
 	initOnce.Do(func() {
 		runtime.LockOSThread()
 
-		// Set GDK_BACKEND=x11 if currently unset and XDG_SESSION_TYPE is unset, unspecified or x11 to prevent warnings
-		if os.Getenv("GDK_BACKEND") == "" && (os.Getenv("XDG_SESSION_TYPE") == "" || os.Getenv("XDG_SESSION_TYPE") == "unspecified" || os.Getenv("XDG_SESSION_TYPE") == "x11") {
-			_ = os.Setenv("GDK_BACKEND", "x11")
-		}
-
-		if ok := C.gtk_init_check(nil, nil); ok != 1 {
-			panic(errors.New("failed to init GTK"))
+		done := startupTrace.span("gtk_init")
+		if err := initGTK(); err != nil {
+			panic(err)
 		}
+		done()
 	})
 
+	// A second instance exits before it creates a web process
+	if appoptions.SingleInstanceLock != nil {
+		done := startupTrace.span("single_instance")
+		SetupSingleInstance(appoptions.SingleInstanceLock)
+		done()
+	}
+
 	result := &Frontend{
 		frontendOptions: appoptions,
 		logger:          myLogger,
@@ -164,27 +172,48 @@ func NewFrontend(ctx context.Context, appoptions *options.App, myLogger *logger.
 			result.startURL.Host = net.JoinHostPort(result.startURL.Host+".localhost", port)
 		}
 
-		var bindings string
-		var err error
-		if _obfuscated, _ := ctx.Value("obfuscated").(bool); !_obfuscated {
-			bindings, err = appBindings.ToJSON()
+		// The bindings and the asset server are prepared while the window and the web process are created, requests
+		// of the web process are queued until the asset server is ready
+		go func() {
+			done := startupTrace.span("bindings")
+			var bindings string
+			var err error
+			if _obfuscated, _ := ctx.Value("obfuscated").(bool); !_obfuscated {
+				bindings, err = appBindings.ToJSON()
+				if err != nil {
+					log.Fatal(err)
+				}
+			} else {
+				appBindings.DB().UpdateObfuscatedCallMap()
+			}
+			done()
+
+			done = startupTrace.span("assetserver")
+			assets, err := assetserver.NewAssetServerMainPage(bindings, appoptions, ctx.Value("assetdir") != nil, myLogger, wailsruntime.RuntimeAssetsBundle)
 			if err != nil {
 				log.Fatal(err)
 			}
-		} else {
-			appBindings.DB().UpdateObfuscatedCallMap()
-		}
-		assets, err := assetserver.NewAssetServerMainPage(bindings, appoptions, ctx.Value("assetdir") != nil, myLogger, wailsruntime.RuntimeAssetsBundle)
-		if err != nil {
-			log.Fatal(err)
-		}
-		result.assets = assets
+			assets.UseRequestScheduler()
+			result.assets.Store(assets)
+			done()
+
+			result.startRequestProcessor()
+		}()
+	}
 
-		go result.startRequestProcessor()
+	if appoptions.Linux != nil {
+		messageQueue.configure(appoptions.Linux.MessageQueue)
+		requestQueue.configure(appoptions.Linux.RequestQueue)
 	}
 
 	go result.startMessageProcessor()
 
+	if appoptions.Linux != nil && appoptions.Linux.OnBinaryMessage != nil {
+		binaryMessageHandler = func(message []byte) {
+			appoptions.Linux.OnBinaryMessage(result.ctx, message)
+		}
+	}
+
 	var _debug = ctx.Value("debug")
 	var _devtoolsEnabled = ctx.Value("devtoolsEnabled")
 
@@ -195,7 +224,19 @@ func NewFrontend(ctx context.Context, appoptions *options.App, myLogger *logger.
 		result.devtoolsEnabled = _devtoolsEnabled.(bool)
 	}
 
+	done := startupTrace.span("window")
 	result.mainWindow = NewWindow(appoptions, result.debug, result.devtoolsEnabled)
+	done()
+
+	// Start loading right away, this spawns the web process while the rest of the app starts up
+	done = startupTrace.span("load_start")
+	result.mainWindow.Load(result.startURL.String())
+	done()
+
+	if appoptions.Linux != nil && appoptions.Linux.WindowEvents {
+		go result.startWindowEventEmitter(result.mainWindow.NotifyGeometryChanges())
+	}
+	go result.startScreenEventEmitter()
 
 	C.install_signal_handlers()
 
@@ -210,9 +251,78 @@ func NewFrontend(ctx context.Context, appoptions *options.App, myLogger *logger.
 	return result
 }
 
+// initGTK initialises GTK on the current thread, which then becomes the main thread
+func initGTK() error {
+	// Set GDK_BACKEND=x11 if currently unset and XDG_SESSION_TYPE is unset, unspecified or x11 to prevent warnings
+	if os.Getenv("GDK_BACKEND") == "" && (os.Getenv("XDG_SESSION_TYPE") == "" || os.Getenv("XDG_SESSION_TYPE") == "unspecified" || os.Getenv("XDG_SESSION_TYPE") == "x11") {
+		_ = os.Setenv("GDK_BACKEND", "x11")
+	}
+
+	if ok := C.gtk_init_check(nil, nil); ok != 1 {
+		return errors.New("failed to init GTK")
+	}
+	return nil
+}
+
+// startWindowEventEmitter emits the `wails:window:geometry` and `wails:window:state` events after the main window
+// changed. Changes that happen while the events are emitted are coalesced.
+func (f *Frontend) startWindowEventEmitter(changed <-chan struct{}) {
+	events, _ := f.ctx.Value("events").(*wailsruntime.Events)
+	if events == nil {
+		return
+	}
+
+	var last C.WindowGeometry
+	lastState := "normal"
+	for range changed {
+		geometry := f.mainWindow.geometry()
+		if geometry.x != last.x || geometry.y != last.y || geometry.width != last.width || geometry.height != last.height {
+			events.Emit("wails:window:geometry", int(geometry.x), int(geometry.y), int(geometry.width), int(geometry.height))
+		}
+
+		state := "normal"
+		switch {
+		case geometry.state&C.GDK_WINDOW_STATE_FULLSCREEN != 0:
+			state = "fullscreen"
+		case geometry.state&C.GDK_WINDOW_STATE_ICONIFIED != 0:
+			state = "minimised"
+		case geometry.state&C.GDK_WINDOW_STATE_MAXIMIZED != 0:
+			state = "maximised"
+		}
+		if state != lastState {
+			events.Emit("wails:window:state", state)
+		}
+
+		last, lastState = geometry, state
+	}
+}
+
+// startScreenEventEmitter emits the `wails:screens:changed` event with all screens after monitors have been added,
+// removed or changed their geometry or scale
+func (f *Frontend) startScreenEventEmitter() {
+	events, _ := f.ctx.Value("events").(*wailsruntime.Events)
+	if events == nil {
+		return
+	}
+
+	for range screensChanged {
+		screens, err := f.ScreenGetAll()
+		if err != nil {
+			f.logger.Error(err.Error())
+			continue
+		}
+		events.Emit("wails:screens:changed", screens)
+	}
+}
+
 func (f *Frontend) startMessageProcessor() {
-	for message := range messageBuffer {
-		f.processMessage(message)
+	for {
+		message := messageQueue.Pop()
+		if message.reply != nil {
+			go f.processMessageWithReply(message.message, message.reply)
+			continue
+		}
+		f.processMessage(message.message)
 	}
 }
 
@@ -241,10 +351,6 @@ func (f *Frontend) Run(ctx context.Context) error {
 		}
 	}()
 
-	if f.frontendOptions.SingleInstanceLock != nil {
-		SetupSingleInstance(f.frontendOptions.SingleInstanceLock.UniqueId)
-	}
-
 	f.mainWindow.Run(f.startURL.String())
 
 	return nil
@@ -341,7 +447,7 @@ func (f *Frontend) WindowSetBackgroundColour(col *options.RGBA) {
 }
 
 func (f *Frontend) ScreenGetAll() ([]Screen, error) {
-	return GetAllScreens(f.mainWindow.asGTKWindow())
+	return GetAllScreens(f.mainWindow)
 }
 
 func (f *Frontend) WindowIsMaximised() bool {
@@ -394,53 +500,20 @@ func (f *Frontend) Notify(name string, data ...interface{}) {
 	f.mainWindow.ExecJS(`window.wails.EventsNotify('` + template.JSEscapeString(string(payload)) + `');`)
 }
 
-var edgeMap = map[string]uintptr{
-	"n-resize":  C.GDK_WINDOW_EDGE_NORTH,
-	"ne-resize": C.GDK_WINDOW_EDGE_NORTH_EAST,
-	"e-resize":  C.GDK_WINDOW_EDGE_EAST,
-	"se-resize": C.GDK_WINDOW_EDGE_SOUTH_EAST,
-	"s-resize":  C.GDK_WINDOW_EDGE_SOUTH,
-	"sw-resize": C.GDK_WINDOW_EDGE_SOUTH_WEST,
-	"w-resize":  C.GDK_WINDOW_EDGE_WEST,
-	"nw-resize": C.GDK_WINDOW_EDGE_NORTH_WEST,
-}
-
 func (f *Frontend) processMessage(message string) {
 	if message == "DomReady" {
+		f.writeStartupTrace()
 		if f.frontendOptions.OnDomReady != nil {
 			f.frontendOptions.OnDomReady(f.ctx)
 		}
 		return
 	}
 
-	if message == "drag" {
-		if !f.mainWindow.IsFullScreen() {
-			f.startDrag()
-		}
-		return
-	}
-
 	if message == "wails:showInspector" {
 		f.mainWindow.ShowInspector()
 		return
 	}
 
-	if strings.HasPrefix(message, "resize:") {
-		if !f.mainWindow.IsFullScreen() {
-			sl := strings.Split(message, ":")
-			if len(sl) != 2 {
-				f.logger.Info("Unknown message returned from dispatcher: %+v", message)
-				return
-			}
-			edge := edgeMap[sl[1]]
-			err := f.startResize(edge)
-			if err != nil {
-				f.logger.Error(err.Error())
-			}
-		}
-		return
-	}
-
 	if message == "runtime:ready" {
 		cmd := fmt.Sprintf(
 			"window.wails.setCSSDragProperties('%s', '%s');\n"+
@@ -474,6 +547,28 @@ func (f *Frontend) processMessage(message string) {
 	}()
 }
 
+// processMessageWithReply processes a call message and delivers the result with the reply of the message, this
+// avoids encoding the result a second time and evaluating it as a callback script.
+func (f *Frontend) processMessageWithReply(message string, reply unsafe.Pointer) {
+	result, err := f.dispatcher.ProcessMessage(message, f)
+	if err != nil {
+		f.logger.Error(err.Error())
+		if result == "" {
+			f.mainWindow.ReplyToMessage(reply, "", err)
+			return
+		}
+	}
+
+	switch {
+	case result == "":
+		result = "null"
+	case result[0] == 'c':
+		// Callback from a method call
+		result = result[1:]
+	}
+	f.mainWindow.ReplyToMessage(reply, result, nil)
+}
+
 func (f *Frontend) Callback(message string) {
 	escaped, err := json.Marshal(message)
 	if err != nil {
@@ -482,38 +577,112 @@ func (f *Frontend) Callback(message string) {
 	f.ExecJS(`window.wails.Callback(` + string(escaped) + `);`)
 }
 
-func (f *Frontend) startDrag() {
-	f.mainWindow.StartDrag()
+func (f *Frontend) ExecJS(js string) {
+	f.mainWindow.ExecJS(js)
+}
+
+type inboundMessage struct {
+	message string
+	// reply is set for messages posted to the `externalWithReply` handler
+	reply unsafe.Pointer
 }
 
-func (f *Frontend) startResize(edge uintptr) error {
-	f.mainWindow.StartResize(edge)
-	return nil
+// GetInboundQueueStats returns a snapshot of the counters of the IPC message and asset request queues
+func GetInboundQueueStats() (messages InboundQueueStats, requests InboundQueueStats) {
+	return messageQueue.Stats(), requestQueue.Stats()
 }
 
-func (f *Frontend) ExecJS(js string) {
-	f.mainWindow.ExecJS(js)
+// With InboundQueueDropOldest an `EventsEmit` drops the oldest queued emit of the same event, all other messages must be
+// processed. Drag and resize are handled by the script message handler in window.c.
+var messageQueue = newInboundQueue[inboundMessage](
+	"message",
+	messageSupersedes,
+	func(m inboundMessage, err error) {
+		if m.reply == nil {
+			return
+		}
+		// Rejects are always handled on the main thread, so the promise can be rejected directly
+		cError := C.CString(err.Error())
+		C.ReplyToMessage(m.reply, nil, cError)
+		C.free(unsafe.Pointer(cError))
+	},
+)
+
+// messageSupersedes reports if the message is an `EventsEmit` of the same event as the queued message
+func messageSupersedes(queued inboundMessage, m inboundMessage) bool {
+	name := emittedEventName(m.message)
+	return name != "" && queued.reply == nil && emittedEventName(queued.message) == name
 }
 
-var messageBuffer = make(chan string, 100)
+// emittedEventName returns the name of the event of an `EventsEmit` message, or "" for other messages and names that
+// have been escaped by JSON.stringify
+func emittedEventName(message string) string {
+	const prefix = `EE{"name":"`
+	if !strings.HasPrefix(message, prefix) {
+		return ""
+	}
+	name, _, found := strings.Cut(message[len(prefix):], `"`)
+	if !found || strings.Contains(name, `\`) {
+		return ""
+	}
+	return name
+}
 
 //export processMessage
 func processMessage(message *C.char) {
-	goMessage := C.GoString(message)
-	messageBuffer <- goMessage
+	messageQueue.Push(inboundMessage{message: C.GoString(message)})
+}
+
+//export processMessageWithReply
+func processMessageWithReply(message *C.char, reply unsafe.Pointer) {
+	messageQueue.Push(inboundMessage{
+		message: C.GoString(message),
+		reply:   reply,
+	})
+}
+
+var binaryMessageHandler func(message []byte)
+
+// processBinaryMessage is called on the main thread for every message posted to the `externalBinary` handler.
+// The message is borrowed from the webview without copying and is only valid until the handler returns.
+//
+//export processBinaryMessage
+func processBinaryMessage(data unsafe.Pointer, length C.gsize) {
+	handler := binaryMessageHandler
+	if handler == nil {
+		return
+	}
+
+	var message []byte
+	if data != nil && length > 0 {
+		message = unsafe.Slice((*byte)(data), int(length))
+	}
+	handler(message)
 }
 
-var requestBuffer = make(chan webview.Request, 100)
+// No request supersedes another one, with InboundQueueDropOldest requests spill like with InboundQueueSpill
+var requestQueue = newInboundQueue[webview.Request](
+	"request",
+	nil,
+	func(r webview.Request, _ error) {
+		r.Response().WriteHeader(http.StatusServiceUnavailable)
+		_ = r.Close()
+	},
+)
 
 func (f *Frontend) startRequestProcessor() {
-	for request := range requestBuffer {
-		f.assets.ServeWebViewRequest(request)
+	request := requestQueue.Pop()
+	startupTrace.add("first_request", f.mainWindow.loadStart, time.Now())
+	assets := f.assets.Load()
+	for {
+		assets.ServeWebViewRequest(request)
+		request = requestQueue.Pop()
 	}
 }
 
 //export processURLRequest
 func processURLRequest(request unsafe.Pointer) {
-	requestBuffer <- webview.NewRequest(request)
+	requestQueue.Push(webview.NewRequest(request))
 }
 
 func (f *Frontend) startSecondInstanceProcessor() {
@@ -11,9 +11,7 @@ package linux
 #include "gtk/gtk.h"
 
 static GtkCheckMenuItem *toGtkCheckMenuItem(void *pointer) { return (GTK_CHECK_MENU_ITEM(pointer)); }
-
-extern void blockClick(GtkWidget* menuItem, gulong handler_id);
-extern void unblockClick(GtkWidget* menuItem, gulong handler_id);
+static GtkRadioMenuItem *toGtkRadioMenuItem(void *pointer) { return (GTK_RADIO_MENU_ITEM(pointer)); }
 */
 import "C"
 import (
@@ -49,30 +47,24 @@ func handleMenuItemClick(gtkWidget unsafe.Pointer) {
 	// main thread will get blocked and so the message loop blocks. As a result the app will block and shows a
 	// "not responding" dialog.
 
-	item := gtkSignalToMenuItem[(*C.GtkWidget)(gtkWidget)]
+	node := menuNodeByWidget[(*C.GtkWidget)(gtkWidget)]
+	if node == nil {
+		return
+	}
+	item := node.item
 	switch item.Type {
 	case menu.CheckboxType:
 		item.Checked = !item.Checked
-		checked := C.int(0)
-		if item.Checked {
-			checked = C.int(1)
-		}
-		for _, gtkCheckbox := range gtkCheckboxCache[item] {
-			handler := gtkSignalHandlers[gtkCheckbox]
-			C.blockClick(gtkCheckbox, handler)
-			C.gtk_check_menu_item_set_active(C.toGtkCheckMenuItem(unsafe.Pointer(gtkCheckbox)), checked)
-			C.unblockClick(gtkCheckbox, handler)
+		for _, gtkCheckbox := range menuNodesByItem[item] {
+			gtkCheckbox.setChecked(item.Checked)
 		}
 		go item.Click(&menu.CallbackData{MenuItem: item})
 	case menu.RadioType:
-		gtkRadioItems := gtkRadioMenuCache[item]
 		active := C.gtk_check_menu_item_get_active(C.toGtkCheckMenuItem(gtkWidget))
 		if int(active) == 1 {
-			for _, gtkRadioItem := range gtkRadioItems {
-				handler := gtkSignalHandlers[gtkRadioItem]
-				C.blockClick(gtkRadioItem, handler)
-				C.gtk_check_menu_item_set_active(C.toGtkCheckMenuItem(unsafe.Pointer(gtkRadioItem)), 1)
-				C.unblockClick(gtkRadioItem, handler)
+			for _, gtkRadioItem := range menuNodesByItem[item] {
+				gtkRadioItem.setChecked(true)
+				uncheckRadioGroup(gtkRadioItem)
 			}
 			item.Checked = true
 			go item.Click(&menu.CallbackData{MenuItem: item})
@@ -83,3 +75,14 @@ func handleMenuItemClick(gtkWidget unsafe.Pointer) {
 		go item.Click(&menu.CallbackData{MenuItem: item})
 	}
 }
+
+// uncheckRadioGroup unchecks the other items of the group in the menu model, GTK already deactivated their widgets
+func uncheckRadioGroup(node *menuNode) {
+	group := C.gtk_radio_menu_item_get_group(C.toGtkRadioMenuItem(unsafe.Pointer(node.widget)))
+	for ; group != nil; group = group.next {
+		other := menuNodeByWidget[(*C.GtkWidget)(group.data)]
+		if other != nil && other.item != node.item {
+			other.item.Checked = false
+		}
+	}
+}
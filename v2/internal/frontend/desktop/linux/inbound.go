@@ -0,0 +1,215 @@
+//go:build linux
+// +build linux
+
+package linux
+
+import (
+	"fmt"
+	"sync"
+	"time"
+
+	"github.com/wailsapp/wails/v2/pkg/options/linux"
+)
+
+const defaultInboundQueueCapacity = 100
+
+// InboundQueueWaitBuckets are the upper bounds of the wait histogram buckets, the last bucket counts all waits above
+// the last bound.
+var InboundQueueWaitBuckets = [...]time.Duration{
+	10 * time.Microsecond,
+	100 * time.Microsecond,
+	time.Millisecond,
+	10 * time.Millisecond,
+	100 * time.Millisecond,
+	time.Second,
+}
+
+// InboundQueueStats are the counters of an inbound IPC queue
+type InboundQueueStats struct {
+	// Depth is the number of queued items
+	Depth int
+	// HighWaterMark is the highest depth the queue has ever reached
+	HighWaterMark int
+	// Enqueued is the total number of enqueued items
+	Enqueued uint64
+	// Spilled is the number of items that were enqueued while the queue was at its capacity
+	Spilled uint64
+	// Dropped is the number of items that have been dropped in favour of newer items that supersede them
+	Dropped uint64
+	// Rejected is the number of items that have been rejected because the queue was at its capacity
+	Rejected uint64
+	// WaitHistogram counts how long items waited in the queue until they were processed, see InboundQueueWaitBuckets
+	WaitHistogram [len(InboundQueueWaitBuckets) + 1]uint64
+}
+
+type inboundItem[T any] struct {
+	value    T
+	enqueued time.Time
+}
+
+// inboundQueue is the queue between the exported callbacks, that are called on the main thread, and the Go
+// processors. Push never blocks, so the main thread can't be frozen by the Go side falling behind. What happens once
+// the capacity has been reached is defined by the policy.
+type inboundQueue[T any] struct {
+	name string
+
+	// supersedes reports if the new item makes the queued one obsolete, so the queued one may be dropped
+	supersedes func(queued T, value T) bool
+	// reject is called for items that have been rejected or dropped
+	reject func(T, error)
+
+	mu       sync.Mutex
+	items    []inboundItem[T]
+	head     int
+	capacity int
+	policy   linux.InboundQueuePolicy
+	onReject func(error)
+	stats    InboundQueueStats
+
+	notify chan struct{}
+}
+
+func newInboundQueue[T any](name string, supersedes func(queued T, value T) bool, reject func(T, error)) *inboundQueue[T] {
+	return &inboundQueue[T]{
+		name:       name,
+		supersedes: supersedes,
+		reject:     reject,
+		capacity:   defaultInboundQueueCapacity,
+		policy:     linux.InboundQueueSpill,
+		notify:     make(chan struct{}, 1),
+	}
+}
+
+func (q *inboundQueue[T]) configure(options *linux.InboundQueueOptions) {
+	if options == nil {
+		return
+	}
+
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	if options.Capacity > 0 {
+		q.capacity = options.Capacity
+	}
+	q.policy = options.Policy
+	q.onReject = options.OnReject
+}
+
+// Push adds the item to the queue without ever blocking. Returns false if the item has been rejected.
+func (q *inboundQueue[T]) Push(value T) bool {
+	var dropped *inboundItem[T]
+
+	q.mu.Lock()
+	if depth := len(q.items) - q.head; depth >= q.capacity {
+		switch q.policy {
+		case linux.InboundQueueReject:
+			q.stats.Rejected++
+			onReject := q.onReject
+			q.mu.Unlock()
+
+			err := fmt.Errorf("%s queue is full (capacity %d), item has been rejected", q.name, q.capacity)
+			if q.reject != nil {
+				q.reject(value, err)
+			}
+			if onReject != nil {
+				go onReject(err)
+			}
+			return false
+
+		case linux.InboundQueueDropOldest:
+			dropped = q.dropOldestSuperseded(value)
+			if dropped == nil {
+				q.stats.Spilled++
+			}
+
+		default:
+			q.stats.Spilled++
+		}
+	}
+
+	q.items = append(q.items, inboundItem[T]{value: value, enqueued: time.Now()})
+	q.stats.Enqueued++
+	if depth := len(q.items) - q.head; depth > q.stats.HighWaterMark {
+		q.stats.HighWaterMark = depth
+	}
+	onReject := q.onReject
+	q.mu.Unlock()
+
+	if dropped != nil {
+		err := fmt.Errorf("%s queue is full (capacity %d), item has been dropped", q.name, q.capacity)
+		if q.reject != nil {
+			q.reject(dropped.value, err)
+		}
+		if onReject != nil {
+			go onReject(err)
+		}
+	}
+
+	select {
+	case q.notify <- struct{}{}:
+	default:
+	}
+	return true
+}
+
+// dropOldestSuperseded removes and returns the oldest item that is superseded by value, q.mu must be held
+func (q *inboundQueue[T]) dropOldestSuperseded(value T) *inboundItem[T] {
+	if q.supersedes == nil {
+		return nil
+	}
+
+	for i := q.head; i < len(q.items); i++ {
+		if !q.supersedes(q.items[i].value, value) {
+			continue
+		}
+
+		item := q.items[i]
+		copy(q.items[i:], q.items[i+1:])
+		q.items[len(q.items)-1] = inboundItem[T]{}
+		q.items = q.items[:len(q.items)-1]
+		q.stats.Dropped++
+		return &item
+	}
+	return nil
+}
+
+// Pop returns the oldest item and blocks until one is available
+func (q *inboundQueue[T]) Pop() T {
+	for {
+		q.mu.Lock()
+		if q.head < len(q.items) {
+			item := q.items[q.head]
+			q.items[q.head] = inboundItem[T]{}
+			q.head++
+			if q.head == len(q.items) {
+				q.items = q.items[:0]
+				q.head = 0
+			} else if q.head > len(q.items)/2 {
+				n := copy(q.items, q.items[q.head:])
+				q.items = q.items[:n]
+				q.head = 0
+			}
+			q.stats.WaitHistogram[inboundWaitBucket(time.Since(item.enqueued))]++
+			q.mu.Unlock()
+			return item.value
+		}
+		q.mu.Unlock()
+		<-q.notify
+	}
+}
+
+func (q *inboundQueue[T]) Stats() InboundQueueStats {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	stats := q.stats
+	stats.Depth = len(q.items) - q.head
+	return stats
+}
+
+func inboundWaitBucket(wait time.Duration) int {
+	for i, bound := range InboundQueueWaitBuckets {
+		if wait <= bound {
+			return i
+		}
+	}
+	return len(InboundQueueWaitBuckets)
+}
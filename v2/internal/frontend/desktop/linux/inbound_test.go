@@ -0,0 +1,65 @@
+//go:build linux
+
+package linux
+
+import (
+	"testing"
+
+	"github.com/wailsapp/wails/v2/pkg/options/linux"
+)
+
+func TestEmittedEventName(t *testing.T) {
+	tests := map[string]string{
+		`EE{"name":"progress","data":[1]}`: "progress",
+		`EE{"name":"a\"b","data":[]}`:      "",
+		`EXprogress`:                       "",
+		`C{"name":"progress"}`:             "",
+	}
+	for message, want := range tests {
+		if got := emittedEventName(message); got != want {
+			t.Errorf("%s: got %q, want %q", message, got, want)
+		}
+	}
+}
+
+func TestInboundQueueDropOldest(t *testing.T) {
+	var dropped []string
+	q := newInboundQueue[inboundMessage]("message", messageSupersedes, func(m inboundMessage, err error) {
+		dropped = append(dropped, m.message)
+	})
+	q.configure(&linux.InboundQueueOptions{Capacity: 3, Policy: linux.InboundQueueDropOldest})
+
+	q.Push(inboundMessage{message: `EE{"name":"progress","data":[1]}`})
+	q.Push(inboundMessage{message: `C{"name":"main.App.Save"}`})
+	q.Push(inboundMessage{message: `EE{"name":"progress","data":[2]}`})
+
+	// A call supersedes nothing and spills, an emit drops the oldest emit of its event
+	q.Push(inboundMessage{message: `C{"name":"main.App.Load"}`})
+	q.Push(inboundMessage{message: `EE{"name":"other","data":[]}`})
+	q.Push(inboundMessage{message: `EE{"name":"progress","data":[3]}`})
+
+	if len(dropped) != 1 || dropped[0] != `EE{"name":"progress","data":[1]}` {
+		t.Errorf("dropped %q", dropped)
+	}
+	stats := q.Stats()
+	if stats.Dropped != 1 || stats.Spilled != 2 || stats.Depth != 5 {
+		t.Errorf("unexpected stats %+v", stats)
+	}
+
+	var got []string
+	for i := 0; i < 5; i++ {
+		got = append(got, q.Pop().message)
+	}
+	want := []string{
+		`C{"name":"main.App.Save"}`,
+		`EE{"name":"progress","data":[2]}`,
+		`C{"name":"main.App.Load"}`,
+		`EE{"name":"other","data":[]}`,
+		`EE{"name":"progress","data":[3]}`,
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("got %q, want %q", got, want)
+		}
+	}
+}
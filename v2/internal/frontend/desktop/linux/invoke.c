@@ -0,0 +1,175 @@
+#include <glib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "invoke.h"
+
+// The main thread queue replaces one g_idle_add per call with a single GSource that is woken through an eventfd.
+// Producers push onto a lock-free stack per priority lane and only signal the eventfd if no wakeup is pending yet.
+// The GSource then drains all lanes, highest priority first, in one main loop dispatch.
+// Go closures are queued as tasks of the same lanes (see invoke.go), so all calls of a lane run in the order they were
+// queued, whether they come from C or Go.
+
+typedef struct MainThreadTask
+{
+    struct MainThreadTask *next;
+    GSourceFunc func;
+    gpointer data;
+} MainThreadTask;
+
+typedef struct MainThreadSource
+{
+    GSource source;
+    gpointer fdTag;
+} MainThreadSource;
+
+static MainThreadQueue queue;
+static _Atomic(MainThreadTask *) lanes[INVOKE_PRIORITY_LANES];
+
+extern void invokeCallback(guintptr handle);
+
+static void wakeMainThread()
+{
+    if (!g_atomic_int_compare_and_exchange(&queue.pending, 0, 1))
+    {
+        // A wakeup is already pending, the task will be drained with it
+        return;
+    }
+
+    __atomic_store_n(&queue.wakeTime, g_get_monotonic_time(), __ATOMIC_RELAXED);
+    uint64_t one = 1;
+    ssize_t written = write(queue.eventFd, &one, sizeof(one));
+    (void)written;
+}
+
+// Returns the tasks of a lane in FIFO order
+static MainThreadTask *takeLane(int priority)
+{
+    MainThreadTask *task = atomic_exchange(&lanes[priority], NULL);
+    MainThreadTask *result = NULL;
+    while (task != NULL)
+    {
+        MainThreadTask *next = task->next;
+        task->next = result;
+        result = task;
+        task = next;
+    }
+    return result;
+}
+
+static int drainLane(int priority)
+{
+    int count = 0;
+    MainThreadTask *task = takeLane(priority);
+    while (task != NULL)
+    {
+        MainThreadTask *next = task->next;
+        g_atomic_int_add(&queue.depth[priority], -1);
+        // Tasks are always one-shot, the return value of the function is ignored
+        task->func(task->data);
+        free(task);
+        task = next;
+        count++;
+    }
+    return count;
+}
+
+static gboolean mainThreadSourceDispatch(GSource *source, GSourceFunc callback, gpointer user_data)
+{
+    MainThreadSource *mainThreadSource = (MainThreadSource *)source;
+    if (!(g_source_query_unix_fd(source, mainThreadSource->fdTag) & G_IO_IN))
+    {
+        return G_SOURCE_CONTINUE;
+    }
+
+    uint64_t signals;
+    ssize_t n = read(queue.eventFd, &signals, sizeof(signals));
+    (void)n;
+
+    gint64 latency = g_get_monotonic_time() - __atomic_load_n(&queue.wakeTime, __ATOMIC_RELAXED);
+    __atomic_store_n(&queue.lastDrainLatency, latency, __ATOMIC_RELAXED);
+    if (latency > __atomic_load_n(&queue.maxDrainLatency, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&queue.maxDrainLatency, latency, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&queue.wakeups, 1, __ATOMIC_RELAXED);
+
+    // Reset before draining, everything pushed from now on needs a new wakeup
+    g_atomic_int_set(&queue.pending, 0);
+
+    int drained = 0;
+    for (int priority = 0; priority < INVOKE_PRIORITY_LANES; priority++)
+    {
+        drained += drainLane(priority);
+    }
+    __atomic_add_fetch(&queue.drained, drained, __ATOMIC_RELAXED);
+
+    return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs mainThreadSourceFuncs = {
+    NULL,
+    NULL,
+    mainThreadSourceDispatch,
+    NULL,
+};
+
+MainThreadQueue *MainThreadQueueInit()
+{
+    static gsize initialised = 0;
+    if (g_once_init_enter(&initialised))
+    {
+        queue.eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (queue.eventFd < 0)
+        {
+            g_error("unable to create eventfd for the main thread queue");
+        }
+
+        GSource *source = g_source_new(&mainThreadSourceFuncs, sizeof(MainThreadSource));
+        ((MainThreadSource *)source)->fdTag = g_source_add_unix_fd(source, queue.eventFd, G_IO_IN);
+        g_source_set_priority(source, G_PRIORITY_DEFAULT_IDLE);
+        g_source_set_name(source, "wails-main-thread-queue");
+        g_source_attach(source, NULL);
+        g_source_unref(source);
+
+        g_once_init_leave(&initialised, 1);
+    }
+    return &queue;
+}
+
+void ExecuteOnMainThreadWithPriority(int priority, void *f, gpointer data)
+{
+    MainThreadQueueInit();
+
+    MainThreadTask *task = malloc(sizeof(MainThreadTask));
+    task->func = (GSourceFunc)f;
+    task->data = data;
+
+    MainThreadTask *head = atomic_load(&lanes[priority]);
+    do
+    {
+        task->next = head;
+    } while (!atomic_compare_exchange_weak(&lanes[priority], &head, task));
+    g_atomic_int_inc(&queue.depth[priority]);
+
+    wakeMainThread();
+}
+
+void ExecuteOnMainThread(void *f, gpointer data)
+{
+    ExecuteOnMainThreadWithPriority(INVOKE_PRIORITY_DEFAULT, f, data);
+}
+
+static gboolean runGoCallback(gpointer handle)
+{
+    invokeCallback((guintptr)handle);
+    return G_SOURCE_REMOVE;
+}
+
+// Queues the Go closure of the cgo.Handle on the lane
+void ExecuteGoCallbackOnMainThread(int priority, guintptr handle)
+{
+    ExecuteOnMainThreadWithPriority(priority, runGoCallback, (gpointer)handle);
+}
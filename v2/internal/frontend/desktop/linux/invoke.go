@@ -8,71 +8,120 @@ package linux
 
 #include <stdio.h>
 #include "gtk/gtk.h"
-
-extern gboolean invokeCallbacks(void *);
-
-static inline void triggerInvokesOnMainThread() {
-    g_idle_add((GSourceFunc)invokeCallbacks, NULL);
-}
+#include "invoke.h"
 */
 import "C"
 import (
 	"runtime"
+	"runtime/cgo"
 	"sync"
+	"sync/atomic"
+	"time"
 	"unsafe"
 
 	"golang.org/x/sys/unix"
 )
 
+type invokePriority int
+
+const (
+	// invokePriorityDefault is used for the window operations
+	invokePriorityDefault invokePriority = C.INVOKE_PRIORITY_DEFAULT
+	// invokePriorityLow is for bulk work that doesn't have to keep its order with the window operations, it runs after
+	// all calls of the default lane that are queued when the main thread drains the queue
+	invokePriorityLow invokePriority = C.INVOKE_PRIORITY_LOW
+
+	invokePriorityLanes = C.INVOKE_PRIORITY_LANES
+)
+
 var (
-	m         sync.Mutex
-	mainTid   int
-	dispatchq []func()
+	mainTid int64
+
+	dispatchInit  sync.Once
+	dispatchQueue *C.MainThreadQueue
 )
 
+// InvokeQueueStats are the counters of the main thread dispatch queue
+type InvokeQueueStats struct {
+	// Depth is the number of queued and not yet executed calls per priority lane
+	Depth [invokePriorityLanes]int
+	// Wakeups is the number of main loop dispatches of the queue
+	Wakeups uint64
+	// Drained is the total number of executed calls
+	Drained uint64
+	// LastDrainLatency is the time between the wakeup and the dispatch of the last drain
+	LastDrainLatency time.Duration
+	// MaxDrainLatency is the highest latency observed between a wakeup and its dispatch
+	MaxDrainLatency time.Duration
+}
+
+// GetInvokeQueueStats returns a snapshot of the main thread dispatch queue counters
+func GetInvokeQueueStats() InvokeQueueStats {
+	q := mainThreadQueue()
+
+	var stats InvokeQueueStats
+	for i := 0; i < invokePriorityLanes; i++ {
+		stats.Depth[i] = int(atomic.LoadInt32((*int32)(unsafe.Pointer(&q.depth[i]))))
+	}
+	stats.Wakeups = atomic.LoadUint64((*uint64)(unsafe.Pointer(&q.wakeups)))
+	stats.Drained = atomic.LoadUint64((*uint64)(unsafe.Pointer(&q.drained)))
+	stats.LastDrainLatency = time.Duration(atomic.LoadInt64((*int64)(unsafe.Pointer(&q.lastDrainLatency)))) * time.Microsecond
+	stats.MaxDrainLatency = time.Duration(atomic.LoadInt64((*int64)(unsafe.Pointer(&q.maxDrainLatency)))) * time.Microsecond
+	return stats
+}
+
+func mainThreadQueue() *C.MainThreadQueue {
+	dispatchInit.Do(func() {
+		dispatchQueue = C.MainThreadQueueInit()
+	})
+	return dispatchQueue
+}
+
 func invokeOnMainThread(f func()) {
+	invokeOnMainThreadWithPriority(invokePriorityDefault, f)
+}
+
+func invokeOnMainThreadWithPriority(priority invokePriority, f func()) {
 	if tryInvokeOnCurrentGoRoutine(f) {
 		return
 	}
 
-	m.Lock()
-	dispatchq = append(dispatchq, f)
-	m.Unlock()
+	// The closure is queued on the C lane, so it keeps its order with the window operations queued from C
+	C.ExecuteGoCallbackOnMainThread(C.int(priority), C.guintptr(cgo.NewHandle(f)))
+}
+
+// isMainThread reports if the calling goroutine runs on the main thread
+func isMainThread() bool {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
 
-	C.triggerInvokesOnMainThread()
+	return atomic.LoadInt64(&mainTid) == int64(unix.Gettid())
 }
 
 func tryInvokeOnCurrentGoRoutine(f func()) bool {
-	m.Lock()
-	mainThreadID := mainTid
-	m.Unlock()
+	mainThreadID := atomic.LoadInt64(&mainTid)
 
 	runtime.LockOSThread()
 	defer runtime.UnlockOSThread()
 
-	if mainThreadID != unix.Gettid() {
+	if mainThreadID != int64(unix.Gettid()) {
 		return false
 	}
 	f()
 	return true
 }
 
-//export invokeCallbacks
-func invokeCallbacks(_ unsafe.Pointer) C.gboolean {
+//export invokeCallback
+func invokeCallback(handle C.guintptr) {
 	runtime.LockOSThread()
 	defer runtime.UnlockOSThread()
 
-	m.Lock()
-	if mainTid == 0 {
-		mainTid = unix.Gettid()
+	if atomic.LoadInt64(&mainTid) == 0 {
+		atomic.StoreInt64(&mainTid, int64(unix.Gettid()))
 	}
 
-	q := append([]func(){}, dispatchq...)
-	dispatchq = []func(){}
-	m.Unlock()
-
-	for _, v := range q {
-		v()
-	}
-	return C.G_SOURCE_REMOVE
+	h := cgo.Handle(handle)
+	f := h.Value().(func())
+	h.Delete()
+	f()
 }
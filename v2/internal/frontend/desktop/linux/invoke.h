@@ -0,0 +1,30 @@
+#ifndef invoke_h
+#define invoke_h
+
+#include <glib.h>
+
+// Priority lanes of the main thread queue. Lower values are drained first.
+#define INVOKE_PRIORITY_DEFAULT 0
+#define INVOKE_PRIORITY_LOW 1
+#define INVOKE_PRIORITY_LANES 2
+
+// MainThreadQueue is shared between C and Go. All fields are accessed atomically.
+typedef struct MainThreadQueue
+{
+    int eventFd;
+    gint pending;
+    gint64 wakeTime;
+    gint depth[INVOKE_PRIORITY_LANES];
+    guint64 wakeups;
+    guint64 drained;
+    gint64 lastDrainLatency;
+    gint64 maxDrainLatency;
+} MainThreadQueue;
+
+MainThreadQueue *MainThreadQueueInit();
+
+void ExecuteOnMainThread(void *f, gpointer data);
+void ExecuteOnMainThreadWithPriority(int priority, void *f, gpointer data);
+void ExecuteGoCallbackOnMainThread(int priority, guintptr handle);
+
+#endif /* invoke_h */
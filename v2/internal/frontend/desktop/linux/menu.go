@@ -8,10 +8,13 @@ package linux
 #cgo !webkit2_41 pkg-config: webkit2gtk-4.0
 #cgo webkit2_41 pkg-config: webkit2gtk-4.1
 
+#include <stdlib.h>
 #include "gtk/gtk.h"
 
 static GtkMenuItem *toGtkMenuItem(void *pointer) { return (GTK_MENU_ITEM(pointer)); }
 static GtkMenuShell *toGtkMenuShell(void *pointer) { return (GTK_MENU_SHELL(pointer)); }
+static GtkContainer *toGtkContainer(void *pointer) { return (GTK_CONTAINER(pointer)); }
+static GtkBox *toGtkBox(void *pointer) { return (GTK_BOX(pointer)); }
 static GtkCheckMenuItem *toGtkCheckMenuItem(void *pointer) { return (GTK_CHECK_MENU_ITEM(pointer)); }
 static GtkRadioMenuItem *toGtkRadioMenuItem(void *pointer) { return (GTK_RADIO_MENU_ITEM(pointer)); }
 
@@ -29,22 +32,62 @@ gulong connectClick(GtkWidget* menuItem) {
 	return g_signal_connect(menuItem, "activate", G_CALLBACK(handleMenuItemClick), (void*)menuItem);
 }
 
+void disconnectClick(GtkWidget* menuItem, gulong handler_id) {
+	g_signal_handler_disconnect(menuItem, handler_id);
+}
+
 void addAccelerator(GtkWidget* menuItem, GtkAccelGroup* group, guint key, GdkModifierType mods) {
 	gtk_widget_add_accelerator(menuItem, "activate", group, key, mods, GTK_ACCEL_VISIBLE);
 }
+
+void removeAccelerator(GtkWidget* menuItem, GtkAccelGroup* group, guint key, GdkModifierType mods) {
+	gtk_widget_remove_accelerator(menuItem, group, key, mods);
+}
+
+// moveMenuItem moves an item that is already in the shell to the given position
+void moveMenuItem(GtkWidget* shell, GtkWidget* menuItem, int position) {
+	g_object_ref(menuItem);
+	gtk_container_remove(toGtkContainer(shell), menuItem);
+	gtk_menu_shell_insert(toGtkMenuShell(shell), menuItem, position);
+	g_object_unref(menuItem);
+}
 */
 import "C"
-import "github.com/wailsapp/wails/v2/pkg/menu"
-import "unsafe"
-
-var menuIdCounter int
-var menuItemToId map[*menu.MenuItem]int
-var menuIdToItem map[int]*menu.MenuItem
-var gtkCheckboxCache map[*menu.MenuItem][]*C.GtkWidget
-var gtkMenuCache map[*menu.MenuItem]*C.GtkWidget
-var gtkRadioMenuCache map[*menu.MenuItem][]*C.GtkWidget
-var gtkSignalHandlers map[*C.GtkWidget]C.gulong
-var gtkSignalToMenuItem map[*C.GtkWidget]*menu.MenuItem
+import (
+	"unsafe"
+
+	"github.com/wailsapp/wails/v2/pkg/menu"
+)
+
+// menuNode is the retained state of a menu item that is shown in the menubar. Updates of the application menu are
+// diffed against the nodes and only the GTK widgets of changed items are touched.
+type menuNode struct {
+	item   *menu.MenuItem
+	widget *C.GtkWidget
+
+	itemType menu.Type
+	label    string
+	disabled bool
+
+	hasAccelerator bool
+	key            C.guint
+	mods           C.GdkModifierType
+
+	// handler is the click handler, 0 if the item has no click callback
+	handler C.gulong
+
+	// radioGroup is the previous radio item of the group, nil if the item starts a new group
+	radioGroup *menuNode
+
+	// submenu is the GtkMenu of a submenu item and children its shown items
+	submenu  *C.GtkWidget
+	children []*menuNode
+}
+
+// menuNodeByWidget finds the node of a clicked widget, menuNodesByItem all nodes of an item, an item can be shown more
+// than once. They are only accessed on the main thread.
+var menuNodeByWidget = make(map[*C.GtkWidget]*menuNode)
+var menuNodesByItem = make(map[*menu.MenuItem][]*menuNode)
 
 func (f *Frontend) MenuSetApplicationMenu(menu *menu.Menu) {
 	f.mainWindow.SetApplicationMenu(menu)
@@ -54,111 +97,233 @@ func (f *Frontend) MenuUpdateApplicationMenu() {
 	f.mainWindow.SetApplicationMenu(f.mainWindow.applicationMenu)
 }
 
+// SetApplicationMenu shows the menu in the menubar of the window. The menu is diffed against the shown menu, items
+// that are unchanged keep their widgets.
 func (w *Window) SetApplicationMenu(inmenu *menu.Menu) {
 	if inmenu == nil {
 		return
 	}
+	w.applicationMenu = inmenu
 
-	// Setup accelerator group
-	w.accels = C.gtk_accel_group_new()
-	C.gtk_window_add_accel_group(w.asGTKWindow(), w.accels)
+	invokeOnMainThread(func() {
+		if w.menubar == nil {
+			w.accels = C.gtk_accel_group_new()
+			C.gtk_window_add_accel_group(w.asGTKWindow(), w.accels)
+			w.menubar = C.gtk_menu_bar_new()
 
-	menuItemToId = make(map[*menu.MenuItem]int)
-	menuIdToItem = make(map[int]*menu.MenuItem)
-	gtkCheckboxCache = make(map[*menu.MenuItem][]*C.GtkWidget)
-	gtkMenuCache = make(map[*menu.MenuItem]*C.GtkWidget)
-	gtkRadioMenuCache = make(map[*menu.MenuItem][]*C.GtkWidget)
-	gtkSignalHandlers = make(map[*C.GtkWidget]C.gulong)
-	gtkSignalToMenuItem = make(map[*C.GtkWidget]*menu.MenuItem)
+			if C.gtk_widget_get_parent(w.webviewBox) != nil {
+				// The window is already running, put the menubar above the webview
+				C.gtk_box_pack_start(C.toGtkBox(unsafe.Pointer(w.vbox)), w.menubar, 0, 0, 0)
+				C.gtk_box_reorder_child(C.toGtkBox(unsafe.Pointer(w.vbox)), w.menubar, 0)
+			}
+		}
 
-	// Increase ref count?
-	w.menubar = C.gtk_menu_bar_new()
+		w.menuNodes = syncMenuShell(w.menubar, w.menuNodes, inmenu.Items, w.accels)
+		C.gtk_widget_show(w.menubar)
+	})
+}
 
-	processMenu(w, inmenu)
+// syncMenuShell updates the shell from the shown nodes to the items and returns the new nodes. Nodes are reused for
+// the same menu item of the same type, all others are destroyed.
+func syncMenuShell(shell *C.GtkWidget, shown []*menuNode, items []*menu.MenuItem, group *C.GtkAccelGroup) []*menuNode {
+	reusable := make(map[*menu.MenuItem][]*menuNode, len(shown))
+	for _, node := range shown {
+		reusable[node.item] = append(reusable[node.item], node)
+	}
 
-	C.gtk_widget_show(w.menubar)
-}
+	result := make([]*menuNode, 0, len(items))
+	kept := make(map[*menuNode]bool, len(shown))
+	for _, item := range items {
+		if item.Hidden {
+			continue
+		}
 
-func processMenu(window *Window, menu *menu.Menu) {
-	for _, menuItem := range menu.Items {
-		submenu := processSubmenu(menuItem, window.accels)
-		C.gtk_menu_shell_append(C.toGtkMenuShell(unsafe.Pointer(window.menubar)), submenu)
+		var node *menuNode
+		if candidates := reusable[item]; len(candidates) > 0 && candidates[0].itemType == item.Type {
+			node = candidates[0]
+			reusable[item] = candidates[1:]
+			kept[node] = true
+		} else {
+			node = newMenuNode(item)
+		}
+		result = append(result, node)
 	}
-}
 
-func processSubmenu(menuItem *menu.MenuItem, group *C.GtkAccelGroup) *C.GtkWidget {
-	existingMenu := gtkMenuCache[menuItem]
-	if existingMenu != nil {
-		return existingMenu
+	// Destroy the removed items first, the positions of the kept widgets are then those in `current`
+	current := make([]*menuNode, 0, len(kept))
+	for _, node := range shown {
+		if kept[node] {
+			current = append(current, node)
+		} else {
+			node.destroy()
+		}
 	}
-	gtkMenu := C.gtk_menu_new()
-	submenu := GtkMenuItemWithLabel(menuItem.Label)
-	for _, menuItem := range menuItem.SubMenu.Items {
-		menuID := menuIdCounter
-		menuIdToItem[menuID] = menuItem
-		menuItemToId[menuItem] = menuID
-		menuIdCounter++
-		processMenuItem(gtkMenu, menuItem, group)
+
+	var radioGroup *menuNode
+	var regroup bool
+	for position, node := range result {
+		if position >= len(current) || current[position] != node {
+			if kept[node] {
+				C.moveMenuItem(shell, node.widget, C.int(position))
+				current = removeMenuNode(current, node)
+			} else {
+				C.gtk_menu_shell_insert(C.toGtkMenuShell(unsafe.Pointer(shell)), node.widget, C.int(position))
+			}
+			current = append(current[:position], append([]*menuNode{node}, current[position:]...)...)
+		}
+
+		if node.itemType == menu.RadioType {
+			// Once an item changed its group, the following items of the run have to join it again
+			regroup = node.joinRadioGroup(radioGroup, regroup)
+			radioGroup = node
+		} else {
+			radioGroup, regroup = nil, false
+		}
+
+		node.update(group)
 	}
-	C.gtk_menu_item_set_submenu(C.toGtkMenuItem(unsafe.Pointer(submenu)), gtkMenu)
-	gtkMenuCache[menuItem] = existingMenu
-	return submenu
+	return result
 }
 
-var currentRadioGroup *C.GSList
+func removeMenuNode(nodes []*menuNode, node *menuNode) []*menuNode {
+	for i, n := range nodes {
+		if n == node {
+			return append(nodes[:i], nodes[i+1:]...)
+		}
+	}
+	return nodes
+}
 
-func processMenuItem(parent *C.GtkWidget, menuItem *menu.MenuItem, group *C.GtkAccelGroup) {
-	if menuItem.Hidden {
-		return
+func newMenuNode(item *menu.MenuItem) *menuNode {
+	node := &menuNode{
+		item:     item,
+		itemType: item.Type,
+		label:    item.Label,
 	}
 
-	if menuItem.Type != menu.RadioType {
-		currentRadioGroup = nil
+	switch item.Type {
+	case menu.SeparatorType:
+		node.widget = C.gtk_separator_menu_item_new()
+	case menu.CheckboxType:
+		node.widget = GtkCheckMenuItemWithLabel(item.Label)
+	case menu.RadioType:
+		node.widget = GtkRadioMenuItemWithLabel(item.Label, nil)
+	case menu.SubmenuType:
+		node.widget = GtkMenuItemWithLabel(item.Label)
+		node.submenu = C.gtk_menu_new()
+		C.gtk_menu_item_set_submenu(C.toGtkMenuItem(unsafe.Pointer(node.widget)), node.submenu)
+	default:
+		node.widget = GtkMenuItemWithLabel(item.Label)
 	}
+	C.gtk_widget_show(node.widget)
+
+	menuNodeByWidget[node.widget] = node
+	menuNodesByItem[item] = append(menuNodesByItem[item], node)
+	return node
+}
 
-	if menuItem.Type == menu.SeparatorType {
-		result := C.gtk_separator_menu_item_new()
-		C.gtk_menu_shell_append(C.toGtkMenuShell(unsafe.Pointer(parent)), result)
+// update applies the changes of the menu item to the widget
+func (n *menuNode) update(group *C.GtkAccelGroup) {
+	item := n.item
+	if n.itemType == menu.SeparatorType {
 		return
 	}
 
-	var result *C.GtkWidget
+	if item.Label != n.label {
+		cLabel := C.CString(item.Label)
+		C.gtk_menu_item_set_label(C.toGtkMenuItem(unsafe.Pointer(n.widget)), cLabel)
+		C.free(unsafe.Pointer(cLabel))
+		n.label = item.Label
+	}
 
-	switch menuItem.Type {
-	case menu.TextType:
-		result = GtkMenuItemWithLabel(menuItem.Label)
-	case menu.CheckboxType:
-		result = GtkCheckMenuItemWithLabel(menuItem.Label)
-		if menuItem.Checked {
-			C.gtk_check_menu_item_set_active(C.toGtkCheckMenuItem(unsafe.Pointer(result)), 1)
+	if item.Disabled != n.disabled {
+		C.gtk_widget_set_sensitive(n.widget, gtkBool(!item.Disabled))
+		n.disabled = item.Disabled
+	}
+
+	var key C.guint
+	var mods C.GdkModifierType
+	if item.Accelerator != nil {
+		key, mods = acceleratorToGTK(item.Accelerator)
+	}
+	if (item.Accelerator != nil) != n.hasAccelerator || key != n.key || mods != n.mods {
+		if n.hasAccelerator {
+			C.removeAccelerator(n.widget, group, n.key, n.mods)
 		}
-		gtkCheckboxCache[menuItem] = append(gtkCheckboxCache[menuItem], result)
+		if item.Accelerator != nil {
+			C.addAccelerator(n.widget, group, key, mods)
+		}
+		n.hasAccelerator, n.key, n.mods = item.Accelerator != nil, key, mods
+	}
 
-	case menu.RadioType:
-		result = GtkRadioMenuItemWithLabel(menuItem.Label, currentRadioGroup)
-		currentRadioGroup = C.gtk_radio_menu_item_get_group(C.toGtkRadioMenuItem(unsafe.Pointer(result)))
-		if menuItem.Checked {
-			C.gtk_check_menu_item_set_active(C.toGtkCheckMenuItem(unsafe.Pointer(result)), 1)
+	if (item.Click != nil) != (n.handler != 0) {
+		if n.handler != 0 {
+			C.disconnectClick(n.widget, n.handler)
+			n.handler = 0
+		} else {
+			n.handler = C.connectClick(n.widget)
 		}
-		gtkRadioMenuCache[menuItem] = append(gtkRadioMenuCache[menuItem], result)
-	case menu.SubmenuType:
-		result = processSubmenu(menuItem, group)
 	}
-	C.gtk_menu_shell_append(C.toGtkMenuShell(unsafe.Pointer(parent)), result)
-	C.gtk_widget_show(result)
 
-	if menuItem.Click != nil {
-		handler := C.connectClick(result)
-		gtkSignalHandlers[result] = handler
-		gtkSignalToMenuItem[result] = menuItem
+	if n.itemType == menu.CheckboxType || n.itemType == menu.RadioType {
+		n.setChecked(item.Checked)
+	}
+
+	if n.itemType == menu.SubmenuType && item.SubMenu != nil {
+		n.children = syncMenuShell(n.submenu, n.children, item.SubMenu.Items, group)
 	}
+}
+
+// setChecked updates the check state without emitting a click
+func (n *menuNode) setChecked(checked bool) {
+	checkItem := C.toGtkCheckMenuItem(unsafe.Pointer(n.widget))
+	if (C.gtk_check_menu_item_get_active(checkItem) != 0) == checked {
+		return
+	}
+
+	if n.handler != 0 {
+		C.blockClick(n.widget, n.handler)
+		defer C.unblockClick(n.widget, n.handler)
+	}
+	C.gtk_check_menu_item_set_active(checkItem, gtkBool(checked))
+}
+
+// joinRadioGroup moves the radio item into the group of previous, into a group of its own if previous is nil. It
+// returns whether the item joined a group.
+func (n *menuNode) joinRadioGroup(previous *menuNode, force bool) bool {
+	if n.radioGroup == previous && !force {
+		return false
+	}
+
+	var previousItem *C.GtkRadioMenuItem
+	if previous != nil {
+		previousItem = C.toGtkRadioMenuItem(unsafe.Pointer(previous.widget))
+	}
+	if n.handler != 0 {
+		C.blockClick(n.widget, n.handler)
+		defer C.unblockClick(n.widget, n.handler)
+	}
+	C.gtk_radio_menu_item_join_group(C.toGtkRadioMenuItem(unsafe.Pointer(n.widget)), previousItem)
+	n.radioGroup = previous
+	return true
+}
+
+// destroy destroys the widget together with its submenu and forgets the nodes
+func (n *menuNode) destroy() {
+	n.forget()
+	C.gtk_widget_destroy(n.widget)
+}
 
-	if menuItem.Disabled {
-		C.gtk_widget_set_sensitive(result, 0)
+func (n *menuNode) forget() {
+	for _, child := range n.children {
+		child.forget()
 	}
 
-	if menuItem.Accelerator != nil {
-		key, mods := acceleratorToGTK(menuItem.Accelerator)
-		C.addAccelerator(result, group, key, mods)
+	delete(menuNodeByWidget, n.widget)
+	nodes := removeMenuNode(menuNodesByItem[n.item], n)
+	if len(nodes) == 0 {
+		delete(menuNodesByItem, n.item)
+	} else {
+		menuNodesByItem[n.item] = nodes
 	}
 }
@@ -0,0 +1,97 @@
+#include "screen.h"
+
+// The monitors are read from GDK once and again after GDK reported a change, instead of querying them for every
+// ScreenGetAll call. Windows get their current monitor refreshed when monitors are added or removed.
+
+extern void processScreenTopologyChanged();
+
+static GSList *windows = NULL;
+
+static void topologyChanged()
+{
+    for (GSList *iter = windows; iter != NULL; iter = g_slist_next(iter))
+    {
+        UpdateWindowMonitor((WindowState *)iter->data);
+    }
+    processScreenTopologyChanged();
+}
+
+static void monitorChanged(GdkMonitor *monitor, GParamSpec *pspec, gpointer data)
+{
+    topologyChanged();
+}
+
+static void watchMonitor(GdkMonitor *monitor)
+{
+    g_signal_connect(monitor, "notify::geometry", G_CALLBACK(monitorChanged), NULL);
+    g_signal_connect(monitor, "notify::scale-factor", G_CALLBACK(monitorChanged), NULL);
+}
+
+static void monitorAdded(GdkDisplay *display, GdkMonitor *monitor, gpointer data)
+{
+    watchMonitor(monitor);
+    topologyChanged();
+}
+
+static void monitorRemoved(GdkDisplay *display, GdkMonitor *monitor, gpointer data)
+{
+    g_signal_handlers_disconnect_by_func(monitor, monitorChanged, NULL);
+    topologyChanged();
+}
+
+static void monitorsChanged(GdkScreen *screen, gpointer data)
+{
+    // Also emitted if the primary monitor changed
+    topologyChanged();
+}
+
+// Must be called on the main thread
+void ScreenTopologyInit()
+{
+    static gboolean initialised = FALSE;
+    if (initialised)
+    {
+        return;
+    }
+    initialised = TRUE;
+
+    GdkDisplay *display = gdk_display_get_default();
+    int count = gdk_display_get_n_monitors(display);
+    for (int i = 0; i < count; i++)
+    {
+        watchMonitor(gdk_display_get_monitor(display, i));
+    }
+    g_signal_connect(display, "monitor-added", G_CALLBACK(monitorAdded), NULL);
+    g_signal_connect(display, "monitor-removed", G_CALLBACK(monitorRemoved), NULL);
+    g_signal_connect(gdk_display_get_default_screen(display), "monitors-changed", G_CALLBACK(monitorsChanged), NULL);
+}
+
+// Must be called on the main thread, returns the number of monitors
+int GetScreens(Screen *screens, int max)
+{
+    GdkDisplay *display = gdk_display_get_default();
+    int count = gdk_display_get_n_monitors(display);
+    for (int i = 0; i < count && i < max; i++)
+    {
+        GdkMonitor *monitor = gdk_display_get_monitor(display, i);
+        GdkRectangle geometry;
+        gdk_monitor_get_geometry(monitor, &geometry);
+
+        screens[i].monitor = monitor;
+        screens[i].isPrimary = gdk_monitor_is_primary(monitor);
+        screens[i].width = geometry.width;
+        screens[i].height = geometry.height;
+        screens[i].scale = gdk_monitor_get_scale_factor(monitor);
+    }
+    return count;
+}
+
+void ScreenTopologyAddWindow(WindowState *state)
+{
+    windows = g_slist_prepend(windows, state);
+}
+
+void ScreenTopologyRemoveWindow(WindowState *state)
+{
+    windows = g_slist_remove(windows, state);
+}
@@ -4,49 +4,17 @@
 package linux
 
 /*
-#cgo linux pkg-config: gtk+-3.0 
+#cgo linux pkg-config: gtk+-3.0
 #cgo !webkit2_41 pkg-config: webkit2gtk-4.0
 #cgo webkit2_41 pkg-config: webkit2gtk-4.1
 
-#cgo CFLAGS: -w
-#include <stdio.h>
-#include "webkit2/webkit2.h"
-#include "gtk/gtk.h"
-#include "gdk/gdk.h"
-
-typedef struct Screen {
-	int isCurrent;
-	int isPrimary;
-	int height;
-	int width;
-	int scale;
-} Screen;
-
-int GetNMonitors(GtkWindow *window){
-	GdkWindow *gdk_window = gtk_widget_get_window(GTK_WIDGET(window));
-	GdkDisplay *display = gdk_window_get_display(gdk_window);
-	return gdk_display_get_n_monitors(display);
-}
-
-Screen GetNThMonitor(int monitor_num, GtkWindow *window){
-	GdkWindow *gdk_window = gtk_widget_get_window(GTK_WIDGET(window));
-	GdkDisplay *display = gdk_window_get_display(gdk_window);
-	GdkMonitor *monitor = gdk_display_get_monitor(display,monitor_num);
-	GdkMonitor *currentMonitor = gdk_display_get_monitor_at_window(display,gdk_window);
-	Screen screen;
-	GdkRectangle geometry;
-	gdk_monitor_get_geometry(monitor,&geometry);
-	screen.isCurrent = currentMonitor==monitor;
-	screen.isPrimary = gdk_monitor_is_primary(monitor);
-	screen.height = geometry.height;
-	screen.width = geometry.width;
-	screen.scale = gdk_monitor_get_scale_factor(monitor);
-	return screen;
-}
+#include "screen.h"
 */
 import "C"
 import (
 	"sync"
+	"sync/atomic"
+	"unsafe"
 
 	"github.com/pkg/errors"
 	"github.com/wailsapp/wails/v2/internal/frontend"
@@ -54,38 +22,91 @@ import (
 
 type Screen = frontend.Screen
 
-func GetAllScreens(window *C.GtkWindow) ([]Screen, error) {
+type cachedScreen struct {
+	monitor   unsafe.Pointer
+	isPrimary bool
+	width     int
+	height    int
+	scale     int
+}
+
+var (
+	screenTopologyInit sync.Once
+	screenTopology     atomic.Pointer[[]cachedScreen]
+
+	// screensChanged is signalled after the monitor topology changed, changes are coalesced
+	screensChanged = make(chan struct{}, 1)
+)
+
+// initScreenTopology reads the monitors and starts listening to changes, it must be called on the main thread
+func initScreenTopology() {
+	screenTopologyInit.Do(func() {
+		C.ScreenTopologyInit()
+		updateScreenTopology()
+	})
+}
+
+// updateScreenTopology must be called on the main thread
+func updateScreenTopology() {
+	cScreens := make([]C.Screen, 4)
+	count := int(C.GetScreens(&cScreens[0], C.int(len(cScreens))))
+	if count > len(cScreens) {
+		cScreens = make([]C.Screen, count)
+		count = int(C.GetScreens(&cScreens[0], C.int(len(cScreens))))
+	}
+
+	screens := make([]cachedScreen, 0, count)
+	for _, cScreen := range cScreens[:count] {
+		screens = append(screens, cachedScreen{
+			monitor:   cScreen.monitor,
+			isPrimary: cScreen.isPrimary == 1,
+			width:     int(cScreen.width),
+			height:    int(cScreen.height),
+			scale:     int(cScreen.scale),
+		})
+	}
+	screenTopology.Store(&screens)
+}
+
+//export processScreenTopologyChanged
+func processScreenTopologyChanged() {
+	updateScreenTopology()
+	select {
+	case screensChanged <- struct{}{}:
+	default:
+	}
+}
+
+// GetAllScreens returns the cached monitors, it doesn't wait for the main thread
+func GetAllScreens(window *Window) ([]Screen, error) {
 	if window == nil {
 		return nil, errors.New("window is nil, cannot perform screen operations")
 	}
-	var wg sync.WaitGroup
-	var screens []Screen
-	wg.Add(1)
-	invokeOnMainThread(func() {
-		numMonitors := C.GetNMonitors(window)
-		for i := 0; i < int(numMonitors); i++ {
-			cMonitor := C.GetNThMonitor(C.int(i), window)
-
-			screen := Screen{
-				IsCurrent: cMonitor.isCurrent == 1,
-				IsPrimary: cMonitor.isPrimary == 1,
-				Width:     int(cMonitor.width),
-				Height:    int(cMonitor.height),
-
-				Size: frontend.ScreenSize{
-					Width:  int(cMonitor.width),
-					Height: int(cMonitor.height),
-				},
-				PhysicalSize: frontend.ScreenSize{
-					Width:  int(cMonitor.width * cMonitor.scale),
-					Height: int(cMonitor.height * cMonitor.scale),
-				},
-			}
-			screens = append(screens, screen)
-		}
 
-		wg.Done()
-	})
-	wg.Wait()
+	cached := screenTopology.Load()
+	if cached == nil {
+		return nil, errors.New("screens are not available before the window has been created")
+	}
+
+	current := atomic.LoadPointer((*unsafe.Pointer)(unsafe.Pointer(&window.windowState.monitor)))
+	screens := make([]Screen, 0, len(*cached))
+	for _, cScreen := range *cached {
+		screen := Screen{
+			IsCurrent: cScreen.monitor == current,
+			IsPrimary: cScreen.isPrimary,
+			Width:     cScreen.width,
+			Height:    cScreen.height,
+
+			Size: frontend.ScreenSize{
+				Width:  cScreen.width,
+				Height: cScreen.height,
+			},
+			PhysicalSize: frontend.ScreenSize{
+				Width:  cScreen.width * cScreen.scale,
+				Height: cScreen.height * cScreen.scale,
+			},
+		}
+		screens = append(screens, screen)
+	}
 	return screens, nil
 }
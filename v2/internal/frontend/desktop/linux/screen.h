@@ -0,0 +1,21 @@
+#ifndef screen_h
+#define screen_h
+
+#include <gtk/gtk.h>
+#include "window.h"
+
+typedef struct Screen
+{
+    void *monitor;
+    int isPrimary;
+    int height;
+    int width;
+    int scale;
+} Screen;
+
+void ScreenTopologyInit();
+int GetScreens(Screen *screens, int max);
+void ScreenTopologyAddWindow(WindowState *state);
+void ScreenTopologyRemoveWindow(WindowState *state);
+
+#endif /* screen_h */
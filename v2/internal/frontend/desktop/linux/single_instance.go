@@ -4,12 +4,38 @@
 package linux
 
 import (
+	"encoding/binary"
 	"encoding/json"
-	"github.com/godbus/dbus/v5"
-	"github.com/wailsapp/wails/v2/pkg/options"
+	"errors"
+	"fmt"
+	"io"
 	"log"
+	"net"
 	"os"
 	"strings"
+	"syscall"
+	"time"
+
+	"github.com/godbus/dbus/v5"
+	"github.com/wailsapp/wails/v2/pkg/options"
+	"golang.org/x/sys/unix"
+)
+
+// The single instance lock is an abstract UNIX socket, it doesn't need the session bus and vanishes together with the
+// process. The second instance forwards its data in a single write and waits for the acknowledgement before it exits.
+// D-Bus is used where abstract sockets are not shared between instances, or if the socket can't be created. Once the
+// socket is held by another instance, that instance is the first one and D-Bus must not be used: the first instance
+// hasn't registered its name there.
+
+const (
+	singleInstanceMagic = "WSI1"
+
+	// singleInstanceTimeout bounds how long a second instance waits for the first one in a single attempt
+	singleInstanceTimeout = 2 * time.Second
+
+	// singleInstanceAttempts is the number of times a second instance tries to reach the first one before it exits
+	singleInstanceAttempts   = 3
+	singleInstanceRetryDelay = 100 * time.Millisecond
 )
 
 type dbusHandler func(string)
@@ -19,9 +45,219 @@ func (f dbusHandler) SendMessage(message string) *dbus.Error {
 	return nil
 }
 
-func SetupSingleInstance(uniqueID string) {
-	id := "wails_app_" + strings.ReplaceAll(strings.ReplaceAll(uniqueID, "-", "_"), ".", "_")
+func SetupSingleInstance(lock *options.SingleInstanceLock) {
+	id := "wails_app_" + strings.ReplaceAll(strings.ReplaceAll(lock.UniqueId, "-", "_"), ".", "_")
+
+	if !singleInstanceSocketSupported() {
+		setupDBusSingleInstance(id, lock.Data)
+		return
+	}
+
+	for attempt := 1; ; attempt++ {
+		listener, err := listenSingleInstance(id)
+		if err == nil {
+			go serveSingleInstance(listener)
+			return
+		}
+		if !errors.Is(err, syscall.EADDRINUSE) {
+			break
+		}
+
+		// The socket is held by the first instance. If it has exited in the meantime, the next attempt takes over the
+		// socket.
+		data, err := newSecondInstanceData(lock.Data)
+		if err != nil {
+			log.Printf("Failed to get working directory: %v", err)
+			return
+		}
+		err = sendSingleInstance(id, data)
+		if err == nil {
+			os.Exit(1)
+		}
+		if attempt == singleInstanceAttempts {
+			log.Printf("Failed to reach the first instance: %v", err)
+			os.Exit(1)
+		}
+		time.Sleep(singleInstanceRetryDelay)
+	}
+
+	setupDBusSingleInstance(id, lock.Data)
+}
+
+// singleInstanceSocketSupported returns false in sandboxes that may run every instance in its own network namespace,
+// abstract sockets would not be shared between them.
+func singleInstanceSocketSupported() bool {
+	if os.Getenv("FLATPAK_ID") != "" {
+		return false
+	}
+	if _, err := os.Stat("/.flatpak-info"); err == nil {
+		return false
+	}
+	return true
+}
+
+// singleInstanceSocketName is per user, abstract sockets are shared by all users of the network namespace
+func singleInstanceSocketName(id string) string {
+	return fmt.Sprintf("@%s_%d.SingleInstance", id, os.Getuid())
+}
 
+func listenSingleInstance(id string) (net.Listener, error) {
+	return net.Listen("unix", singleInstanceSocketName(id))
+}
+
+func serveSingleInstance(listener net.Listener) {
+	for {
+		conn, err := listener.Accept()
+		if err != nil {
+			return
+		}
+		go func() {
+			defer conn.Close()
+			if data, err := receiveSingleInstance(conn.(*net.UnixConn)); err == nil {
+				secondInstanceBuffer <- data
+			}
+		}()
+	}
+}
+
+func newSecondInstanceData(payload []byte) (options.SecondInstanceData, error) {
+	workingDirectory, err := os.Getwd()
+	return options.SecondInstanceData{
+		Args:             os.Args[1:],
+		WorkingDirectory: workingDirectory,
+		Data:             payload,
+	}, err
+}
+
+func sendSingleInstance(id string, data options.SecondInstanceData) error {
+	conn, err := net.DialTimeout("unix", singleInstanceSocketName(id), singleInstanceTimeout)
+	if err != nil {
+		return err
+	}
+	defer conn.Close()
+
+	_ = conn.SetDeadline(time.Now().Add(singleInstanceTimeout))
+	if _, err := conn.Write(encodeSecondInstanceData(data)); err != nil {
+		return err
+	}
+	if err := conn.(*net.UnixConn).CloseWrite(); err != nil {
+		return err
+	}
+
+	// The first instance acknowledges the data with a single byte once it has been decoded
+	var ack [1]byte
+	_, err = io.ReadFull(conn, ack[:])
+	return err
+}
+
+func receiveSingleInstance(conn *net.UnixConn) (options.SecondInstanceData, error) {
+	_ = conn.SetDeadline(time.Now().Add(singleInstanceTimeout))
+
+	// Only accept instances of the same user
+	raw, err := conn.SyscallConn()
+	if err != nil {
+		return options.SecondInstanceData{}, err
+	}
+	var cred *unix.Ucred
+	var credErr error
+	err = raw.Control(func(fd uintptr) {
+		cred, credErr = unix.GetsockoptUcred(int(fd), unix.SOL_SOCKET, unix.SO_PEERCRED)
+	})
+	if err == nil {
+		err = credErr
+	}
+	if err != nil {
+		return options.SecondInstanceData{}, err
+	}
+	if int(cred.Uid) != os.Getuid() {
+		return options.SecondInstanceData{}, fmt.Errorf("second instance of user %d rejected", cred.Uid)
+	}
+
+	message, err := io.ReadAll(conn)
+	if err != nil {
+		return options.SecondInstanceData{}, err
+	}
+	data, err := decodeSecondInstanceData(message)
+	if err != nil {
+		return options.SecondInstanceData{}, err
+	}
+	_, err = conn.Write([]byte{1})
+	return data, err
+}
+
+// encodeSecondInstanceData encodes the data as the magic followed by the length prefixed arguments, working
+// directory and payload
+func encodeSecondInstanceData(data options.SecondInstanceData) []byte {
+	size := len(singleInstanceMagic) + 4*binary.MaxVarintLen64 + len(data.WorkingDirectory) + len(data.Data)
+	for _, arg := range data.Args {
+		size += binary.MaxVarintLen64 + len(arg)
+	}
+
+	message := make([]byte, 0, size)
+	message = append(message, singleInstanceMagic...)
+	message = binary.AppendUvarint(message, uint64(len(data.Args)))
+	for _, arg := range data.Args {
+		message = binary.AppendUvarint(message, uint64(len(arg)))
+		message = append(message, arg...)
+	}
+	message = binary.AppendUvarint(message, uint64(len(data.WorkingDirectory)))
+	message = append(message, data.WorkingDirectory...)
+	message = binary.AppendUvarint(message, uint64(len(data.Data)))
+	message = append(message, data.Data...)
+	return message
+}
+
+var errInvalidSecondInstanceData = errors.New("invalid second instance data")
+
+func decodeSecondInstanceData(message []byte) (options.SecondInstanceData, error) {
+	var data options.SecondInstanceData
+	if !strings.HasPrefix(string(message), singleInstanceMagic) {
+		return data, errInvalidSecondInstanceData
+	}
+	message = message[len(singleInstanceMagic):]
+
+	next := func() ([]byte, bool) {
+		length, n := binary.Uvarint(message)
+		if n <= 0 || length > uint64(len(message)-n) {
+			return nil, false
+		}
+		field := message[n : n+int(length)]
+		message = message[n+int(length):]
+		return field, true
+	}
+
+	count, n := binary.Uvarint(message)
+	if n <= 0 || count > uint64(len(message)) {
+		return data, errInvalidSecondInstanceData
+	}
+	message = message[n:]
+
+	data.Args = make([]string, count)
+	for i := range data.Args {
+		arg, ok := next()
+		if !ok {
+			return data, errInvalidSecondInstanceData
+		}
+		data.Args[i] = string(arg)
+	}
+
+	workingDirectory, ok := next()
+	if !ok {
+		return data, errInvalidSecondInstanceData
+	}
+	data.WorkingDirectory = string(workingDirectory)
+
+	payload, ok := next()
+	if !ok || len(message) != 0 {
+		return data, errInvalidSecondInstanceData
+	}
+	if len(payload) > 0 {
+		data.Data = payload
+	}
+	return data, nil
+}
+
+func setupDBusSingleInstance(id string, payload []byte) {
 	dbusName := "org." + id + ".SingleInstance"
 	dbusPath := "/org/" + id + "/SingleInstance"
 
@@ -53,10 +289,7 @@ func SetupSingleInstance(uniqueID string) {
 
 	// if name already taken, try to send args to existing instance, if no success just launch new instance
 	if reply == dbus.RequestNameReplyExists {
-		data := options.SecondInstanceData{
-			Args: os.Args[1:],
-		}
-		data.WorkingDirectory, err = os.Getwd()
+		data, err := newSecondInstanceData(payload)
 		if err != nil {
 			log.Printf("Failed to get working directory: %v", err)
 			return
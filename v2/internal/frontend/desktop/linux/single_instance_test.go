@@ -0,0 +1,122 @@
+//go:build linux
+
+package linux
+
+import (
+	"fmt"
+	"os"
+	"reflect"
+	"testing"
+
+	"github.com/godbus/dbus/v5"
+	"github.com/wailsapp/wails/v2/pkg/options"
+)
+
+func TestSecondInstanceDataRoundTrip(t *testing.T) {
+	tests := []options.SecondInstanceData{
+		{Args: []string{}},
+		{Args: []string{"--open", "file with spaces.txt", ""}, WorkingDirectory: "/home/user"},
+		{Args: []string{"ü"}, WorkingDirectory: "/", Data: []byte{0, 1, 2, 255}},
+	}
+
+	for _, want := range tests {
+		got, err := decodeSecondInstanceData(encodeSecondInstanceData(want))
+		if err != nil {
+			t.Fatalf("decode %+v: %v", want, err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Errorf("got %+v, want %+v", got, want)
+		}
+	}
+
+	message := encodeSecondInstanceData(tests[1])
+	for i := 0; i < len(message); i++ {
+		if _, err := decodeSecondInstanceData(message[:i]); err == nil {
+			t.Errorf("decoding a message truncated to %d bytes succeeded", i)
+		}
+	}
+}
+
+func TestSingleInstanceSocket(t *testing.T) {
+	id := fmt.Sprintf("wails_app_test_%d", os.Getpid())
+	listener, err := listenSingleInstance(id)
+	if err != nil {
+		t.Skip(err)
+	}
+	defer listener.Close()
+	go serveSingleInstance(listener)
+
+	if _, err := listenSingleInstance(id); err == nil {
+		t.Fatal("the lock was acquired twice")
+	}
+
+	want := options.SecondInstanceData{Args: []string{"a", "b"}, WorkingDirectory: "/tmp", Data: []byte("payload")}
+	if err := sendSingleInstance(id, want); err != nil {
+		t.Fatal(err)
+	}
+	if got := <-secondInstanceBuffer; !reflect.DeepEqual(got, want) {
+		t.Errorf("got %+v, want %+v", got, want)
+	}
+}
+
+// BenchmarkSingleInstanceSocket measures acquiring and releasing the lock with an abstract UNIX socket, the work done
+// by the first instance at startup.
+func BenchmarkSingleInstanceSocket(b *testing.B) {
+	id := fmt.Sprintf("wails_app_bench_%d", os.Getpid())
+	for i := 0; i < b.N; i++ {
+		listener, err := listenSingleInstance(id)
+		if err != nil {
+			b.Fatal(err)
+		}
+		listener.Close()
+	}
+}
+
+// BenchmarkSingleInstanceDBus measures acquiring and releasing the lock with the session bus, including the connection
+// to the bus that every instance makes at startup.
+func BenchmarkSingleInstanceDBus(b *testing.B) {
+	conn, err := dbus.SessionBusPrivate()
+	if err != nil {
+		b.Skip(err)
+	}
+	conn.Close()
+
+	name := fmt.Sprintf("org.wails_app_bench_%d.SingleInstance", os.Getpid())
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		conn, err := dbus.SessionBusPrivate()
+		if err != nil {
+			b.Fatal(err)
+		}
+		if err := conn.Auth(nil); err != nil {
+			b.Fatal(err)
+		}
+		if err := conn.Hello(); err != nil {
+			b.Fatal(err)
+		}
+		if _, err := conn.RequestName(name, dbus.NameFlagDoNotQueue); err != nil {
+			b.Fatal(err)
+		}
+		conn.Close()
+	}
+}
+
+// BenchmarkSecondInstanceSocket measures forwarding the data of a second instance over the socket
+func BenchmarkSecondInstanceSocket(b *testing.B) {
+	id := fmt.Sprintf("wails_app_bench_second_%d", os.Getpid())
+	listener, err := listenSingleInstance(id)
+	if err != nil {
+		b.Skip(err)
+	}
+	defer listener.Close()
+	go serveSingleInstance(listener)
+
+	data := options.SecondInstanceData{Args: []string{"--open", "file.txt"}, WorkingDirectory: "/tmp"}
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := sendSingleInstance(id, data); err != nil {
+			b.Fatal(err)
+		}
+		<-secondInstanceBuffer
+	}
+}
@@ -0,0 +1,135 @@
+//go:build linux
+// +build linux
+
+package linux
+
+import (
+	"encoding/json"
+	"os"
+	"sync"
+	"time"
+)
+
+// startupTraceEnv names the file the startup trace is written to once the DOM is ready, `-` writes it to stderr
+const startupTraceEnv = "WAILS_STARTUP_TRACE"
+
+// StartupSpan is a named step of the startup. Start and Duration are in microseconds, Start is relative to the
+// initialisation of the process.
+type StartupSpan struct {
+	Name     string `json:"name"`
+	Start    int64  `json:"start_us"`
+	Duration int64  `json:"duration_us"`
+}
+
+type StartupTrace struct {
+	Spans []StartupSpan `json:"spans"`
+
+	// DomReady is the time from the initialisation of the process until the DOM of the start page was ready
+	DomReady int64 `json:"domready_us"`
+
+	// Requests are the webview requests served until the DOM was ready, by request class
+	Requests []StartupRequests `json:"requests,omitempty"`
+}
+
+// StartupRequests are the queue and service times of the webview requests of a class, in microseconds
+type StartupRequests struct {
+	Class          string `json:"class"`
+	Requests       uint64 `json:"requests"`
+	QueueTime      int64  `json:"queue_us"`
+	MaxQueueTime   int64  `json:"max_queue_us"`
+	ServiceTime    int64  `json:"service_us"`
+	MaxServiceTime int64  `json:"max_service_us"`
+}
+
+// startupTracer records the startup spans, spans may be recorded concurrently
+type startupTracer struct {
+	start time.Time
+
+	mu       sync.Mutex
+	spans    []StartupSpan
+	finished bool
+}
+
+// startupTrace starts with the initialisation of this package, which happens before `main`
+var startupTrace = &startupTracer{start: time.Now()}
+
+func (t *startupTracer) add(name string, start time.Time, end time.Time) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if t.finished {
+		return
+	}
+	t.spans = append(t.spans, StartupSpan{
+		Name:     name,
+		Start:    start.Sub(t.start).Microseconds(),
+		Duration: end.Sub(start).Microseconds(),
+	})
+}
+
+// span starts a span that is recorded once the returned function is called
+func (t *startupTracer) span(name string) func() {
+	start := time.Now()
+	return func() {
+		t.add(name, start, time.Now())
+	}
+}
+
+// finish ends the trace and returns it, ok is false if the trace had already been finished
+func (t *startupTracer) finish() (trace StartupTrace, ok bool) {
+	now := time.Now()
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if t.finished {
+		return trace, false
+	}
+	t.finished = true
+	return StartupTrace{Spans: t.spans, DomReady: now.Sub(t.start).Microseconds()}, true
+}
+
+// writeStartupTrace finishes the startup trace and writes it as JSON to the file named by WAILS_STARTUP_TRACE
+func (f *Frontend) writeStartupTrace() {
+	trace, ok := startupTrace.finish()
+	if !ok {
+		return
+	}
+	f.logger.Debug("Startup: DOM ready after %s", time.Duration(trace.DomReady)*time.Microsecond)
+
+	// DomReady can arrive before the startup goroutine has published the asset server
+	if assets := f.assets.Load(); assets != nil {
+		for _, stats := range assets.RequestStats() {
+			if stats.Requests == 0 {
+				continue
+			}
+			trace.Requests = append(trace.Requests, StartupRequests{
+				Class:          stats.Class.String(),
+				Requests:       stats.Requests,
+				QueueTime:      stats.QueueTime.Microseconds(),
+				MaxQueueTime:   stats.MaxQueueTime.Microseconds(),
+				ServiceTime:    stats.ServiceTime.Microseconds(),
+				MaxServiceTime: stats.MaxServiceTime.Microseconds(),
+			})
+		}
+	}
+
+	path := os.Getenv(startupTraceEnv)
+	if path == "" {
+		return
+	}
+
+	data, err := json.Marshal(trace)
+	if err != nil {
+		f.logger.Error("Unable to encode the startup trace: %s", err)
+		return
+	}
+	data = append(data, '\n')
+
+	if path == "-" {
+		_, err = os.Stderr.Write(data)
+	} else {
+		err = os.WriteFile(path, data, 0o644)
+	}
+	if err != nil {
+		f.logger.Error("Unable to write the startup trace: %s", err)
+	}
+}
@@ -0,0 +1,18 @@
+//go:build linux && (webkit2_40 || webkit2_41)
+
+package linux
+
+/*
+#cgo linux pkg-config: gtk+-3.0
+#cgo !webkit2_41 pkg-config: webkit2gtk-4.0
+#cgo webkit2_41 pkg-config: webkit2gtk-4.1
+
+#include "window.h"
+*/
+import "C"
+
+// setupInvokeWithReply registers the `externalWithReply` script message handler, call results are then delivered
+// with the reply of the message instead of executing a callback script.
+func (w *Window) setupInvokeWithReply() bool {
+	return C.SetupInvokeWithReplySignal(w.contentManager) != 0
+}
@@ -0,0 +1,9 @@
+//go:build linux && !(webkit2_40 || webkit2_41)
+
+package linux
+
+// setupInvokeWithReply is not supported before WebKit2GTK 2.40, call results are always delivered by executing a
+// callback script.
+func (w *Window) setupInvokeWithReply() bool {
+	return false
+}
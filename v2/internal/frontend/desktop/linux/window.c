@@ -4,22 +4,12 @@
 #include <stdio.h>
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 #include <locale.h>
 #include "window.h"
-
-// These are the x,y,time & button of the last mouse down event
-// It's used for window dragging
-static float xroot = 0.0f;
-static float yroot = 0.0f;
-static int dragTime = -1;
-static uint mouseButton = 0;
+#include "screen.h"
 
 // casts
-void ExecuteOnMainThread(void *f, gpointer jscallback)
-{
-    g_idle_add((GSourceFunc)f, (gpointer)jscallback);
-}
-
 GtkWidget *GTKWIDGET(void *pointer)
 {
     return GTK_WIDGET(pointer);
@@ -42,6 +32,8 @@ GtkBox *GTKBOX(void *pointer)
 
 extern void processMessage(char *);
 
+static gboolean handleWindowMessage(WindowState *state, const char *message);
+
 static void sendMessageToBackend(WebKitUserContentManager *contentManager,
                                  WebKitJavascriptResult *result,
                                  void *data)
@@ -58,10 +50,70 @@ static void sendMessageToBackend(WebKitUserContentManager *contentManager,
     JSStringGetUTF8CString(js, message, messageSize);
     JSStringRelease(js);
 #endif
-    processMessage(message);
+    // Drag and resize are started right here, they need the timestamp of the button press that is still in progress
+    if (!handleWindowMessage((WindowState *)data, message))
+    {
+        processMessage(message);
+    }
     g_free(message);
 }
 
+extern void processBinaryMessage(void *, gsize);
+
+// The binary message is borrowed from the JSCValue and is only valid during this callback
+static void sendBinaryMessageToBackend(WebKitUserContentManager *contentManager,
+                                       WebKitJavascriptResult *result,
+                                       void *data)
+{
+#if WEBKIT_CHECK_VERSION(2, 38, 0)
+    JSCValue *value = webkit_javascript_result_get_js_value(result);
+    void *message = NULL;
+    gsize messageSize = 0;
+    if (jsc_value_is_array_buffer(value))
+    {
+        message = jsc_value_array_buffer_get_data(value, &messageSize);
+    }
+    else if (jsc_value_is_typed_array(value))
+    {
+        message = jsc_value_typed_array_get_data(value, NULL);
+        messageSize = jsc_value_typed_array_get_size(value);
+    }
+    else
+    {
+        g_warning("externalBinary: only ArrayBuffer and TypedArray messages are supported");
+        return;
+    }
+    processBinaryMessage(message, messageSize);
+#endif
+}
+
+extern void processMessageWithReply(char *, void *);
+
+typedef struct MessageReply
+{
+    void *reply;
+    void *context;
+} MessageReply;
+
+#if WEBKIT_CHECK_VERSION(2, 40, 0)
+static gboolean sendMessageWithReplyToBackend(WebKitUserContentManager *contentManager,
+                                              JSCValue *value,
+                                              WebKitScriptMessageReply *reply,
+                                              void *data)
+{
+    MessageReply *messageReply = malloc(sizeof(MessageReply));
+    messageReply->reply = webkit_script_message_reply_ref(reply);
+    messageReply->context = g_object_ref(jsc_value_get_context(value));
+
+    char *message = jsc_value_to_string(value);
+    processMessageWithReply(message, messageReply);
+    g_free(message);
+
+    // The reply will be sent asynchronously by ReplyToMessage
+    return TRUE;
+}
+#endif
+
 static bool isNULLRectangle(GdkRectangle input)
 {
     return input.x == -1 && input.y == -1 && input.width == -1 && input.height == -1;
@@ -69,6 +121,13 @@ static bool isNULLRectangle(GdkRectangle input)
 
 static GdkMonitor *getCurrentMonitor(GtkWindow *window)
 {
+    // Use the monitor tracked by the window state, see UpdateWindowMonitor
+    WindowState *state = g_object_get_data(G_OBJECT(window), "wails-window-state");
+    if (state != NULL && state->monitor != NULL)
+    {
+        return state->monitor;
+    }
+
     // Get the monitor that the window is currently on
     GdkDisplay *display = gtk_widget_get_display(GTK_WIDGET(window));
     GdkWindow *gdk_window = gtk_widget_get_window(GTK_WIDGET(window));
@@ -105,9 +164,96 @@ static int getCurrentMonitorScaleFactor(GtkWindow *window)
 
 // window
 
-ulong SetupInvokeSignal(void *contentManager)
+static void disconnectFrameClock(WindowState *state)
 {
-    return g_signal_connect((WebKitUserContentManager *)contentManager, "script-message-received::external", G_CALLBACK(sendMessageToBackend), NULL);
+    if (state->frameClock == NULL)
+    {
+        return;
+    }
+    g_signal_handler_disconnect(state->frameClock, state->frameClockHandler);
+    g_object_unref(state->frameClock);
+    state->frameClock = NULL;
+    state->frameClockHandler = 0;
+}
+
+static void freeWindowState(gpointer data)
+{
+    WindowState *state = (WindowState *)data;
+    ScreenTopologyRemoveWindow(state);
+    disconnectFrameClock(state);
+    if (state->monitor != NULL)
+    {
+        g_object_unref(state->monitor);
+    }
+    g_free(state);
+}
+
+WindowState *NewWindowState(GtkWindow *window)
+{
+    WindowState *state = g_new0(WindowState, 1);
+    state->window = window;
+    state->dragTime = -1;
+    // The state lives as long as the window
+    g_object_set_data_full(G_OBJECT(window), "wails-window-state", state, freeWindowState);
+    ScreenTopologyAddWindow(state);
+    return state;
+}
+
+ulong SetupInvokeSignal(void *contentManager, WindowState *state)
+{
+    return g_signal_connect((WebKitUserContentManager *)contentManager, "script-message-received::external", G_CALLBACK(sendMessageToBackend), state);
+}
+
+ulong SetupBinaryInvokeSignal(void *contentManager)
+{
+#if WEBKIT_CHECK_VERSION(2, 38, 0)
+    WebKitUserContentManager *manager = (WebKitUserContentManager *)contentManager;
+    webkit_user_content_manager_register_script_message_handler(manager, "externalBinary");
+    return g_signal_connect(manager, "script-message-received::externalBinary", G_CALLBACK(sendBinaryMessageToBackend), NULL);
+#else
+    return 0;
+#endif
+}
+
+ulong SetupInvokeWithReplySignal(void *contentManager)
+{
+#if WEBKIT_CHECK_VERSION(2, 40, 0)
+    WebKitUserContentManager *manager = (WebKitUserContentManager *)contentManager;
+    webkit_user_content_manager_register_script_message_handler_with_reply(manager, "externalWithReply", NULL);
+    return g_signal_connect(manager, "script-message-with-reply-received::externalWithReply", G_CALLBACK(sendMessageWithReplyToBackend), NULL);
+#else
+    return 0;
+#endif
+}
+
+// Must be called on the main thread. If errorMessage is not NULL the promise of the message gets rejected, otherwise
+// it gets resolved with the parsed json.
+void ReplyToMessage(void *data, char *json, char *errorMessage)
+{
+    MessageReply *messageReply = (MessageReply *)data;
+#if WEBKIT_CHECK_VERSION(2, 40, 0)
+    WebKitScriptMessageReply *reply = (WebKitScriptMessageReply *)messageReply->reply;
+    if (errorMessage != NULL)
+    {
+        webkit_script_message_reply_return_error_message(reply, errorMessage);
+    }
+    else
+    {
+        JSCValue *value = jsc_value_new_from_json(JSC_CONTEXT(messageReply->context), json);
+        if (value == NULL)
+        {
+            webkit_script_message_reply_return_error_message(reply, "invalid JSON in reply");
+        }
+        else
+        {
+            webkit_script_message_reply_return_value(reply, value);
+            g_object_unref(value);
+        }
+    }
+    webkit_script_message_reply_unref(reply);
+    g_object_unref(messageReply->context);
+#endif
+    free(messageReply);
 }
 
 void SetWindowIcon(GtkWindow *window, const guchar *buf, gsize len)
@@ -204,29 +350,6 @@ void SetTitle(GtkWindow *window, char *title)
     ExecuteOnMainThread(setTitle, (gpointer)args);
 }
 
-static gboolean setPosition(gpointer data)
-{
-    SetPositionArgs *args = (SetPositionArgs *)data;
-    gtk_window_move((GtkWindow *)args->window, args->x, args->y);
-    free(args);
-
-    return G_SOURCE_REMOVE;
-}
-
-void SetPosition(void *window, int x, int y)
-{
-    GdkRectangle monitorDimensions = getCurrentMonitorGeometry(window);
-    if (isNULLRectangle(monitorDimensions))
-    {
-        return;
-    }
-    SetPositionArgs *args = malloc(sizeof(SetPositionArgs));
-    args->window = window;
-    args->x = monitorDimensions.x + x;
-    args->y = monitorDimensions.y + y;
-    ExecuteOnMainThread(setPosition, (gpointer)args);
-}
-
 void SetMinMaxSize(GtkWindow *window, int min_width, int min_height, int max_width, int max_height)
 {
     GdkGeometry size;
@@ -245,6 +368,130 @@ void SetMinMaxSize(GtkWindow *window, int min_width, int min_height, int max_wid
     gtk_window_set_geometry_hints(window, NULL, &size, flags);
 }
 
+// Applies the buffered geometry mutations, must be called on the main thread. While the window is fullscreen the size
+// hints stay buffered, so they don't override the hints set by Fullscreen.
+static void applyPendingGeometry(WindowState *state)
+{
+    g_mutex_lock(&state->pendingLock);
+    PendingGeometry pending = state->pending;
+    memset(&state->pending, 0, sizeof(PendingGeometry));
+    if (pending.sizeHints && state->fullscreen)
+    {
+        state->pending.sizeHints = TRUE;
+        state->pending.minWidth = pending.minWidth;
+        state->pending.minHeight = pending.minHeight;
+        state->pending.maxWidth = pending.maxWidth;
+        state->pending.maxHeight = pending.maxHeight;
+        pending.sizeHints = FALSE;
+    }
+    g_mutex_unlock(&state->pendingLock);
+
+    if (pending.sizeHints)
+    {
+        SetMinMaxSize(state->window, pending.minWidth, pending.minHeight, pending.maxWidth, pending.maxHeight);
+        __atomic_add_fetch(&state->geometryApplied, 1, __ATOMIC_RELAXED);
+    }
+    if (pending.size)
+    {
+        gtk_window_resize(state->window, pending.width, pending.height);
+        __atomic_add_fetch(&state->geometryApplied, 1, __ATOMIC_RELAXED);
+    }
+    if (pending.position)
+    {
+        // Positions are relative to the monitor the window is on
+        GdkRectangle monitorDimensions = getCurrentMonitorGeometry(state->window);
+        if (!isNULLRectangle(monitorDimensions))
+        {
+            gtk_window_move(state->window, monitorDimensions.x + pending.x, monitorDimensions.y + pending.y);
+        }
+        __atomic_add_fetch(&state->geometryApplied, 1, __ATOMIC_RELAXED);
+    }
+
+    // Unmapped windows don't get a configure-event
+    UpdateWindowGeometry(state);
+}
+
+static void frameClockUpdate(GdkFrameClock *clock, WindowState *state)
+{
+    // The handler is only connected while mutations are pending, scheduleGeometryUpdate connects it again
+    disconnectFrameClock(state);
+    applyPendingGeometry(state);
+}
+
+static gboolean scheduleGeometryUpdate(gpointer data)
+{
+    WindowState *state = (WindowState *)data;
+
+    GdkWindow *gdkwindow = gtk_widget_get_window(GTK_WIDGET(state->window));
+    if (gdkwindow == NULL || !gtk_widget_get_mapped(GTK_WIDGET(state->window)))
+    {
+        // No frames are drawn, apply the geometry right away
+        applyPendingGeometry(state);
+        return G_SOURCE_REMOVE;
+    }
+
+    GdkFrameClock *clock = gdk_window_get_frame_clock(gdkwindow);
+    if (clock != state->frameClock)
+    {
+        disconnectFrameClock(state);
+        state->frameClock = g_object_ref(clock);
+        state->frameClockHandler = g_signal_connect(clock, "update", G_CALLBACK(frameClockUpdate), state);
+    }
+    gdk_frame_clock_request_phase(clock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+    return G_SOURCE_REMOVE;
+}
+
+// Must be called with pendingLock held
+static void scheduleGeometryLocked(WindowState *state, gboolean collapsed)
+{
+    __atomic_add_fetch(&state->geometryQueued, 1, __ATOMIC_RELAXED);
+    if (collapsed)
+    {
+        __atomic_add_fetch(&state->geometryCollapsed, 1, __ATOMIC_RELAXED);
+    }
+
+    if (!state->pending.scheduled)
+    {
+        state->pending.scheduled = TRUE;
+        ExecuteOnMainThread(scheduleGeometryUpdate, state);
+    }
+}
+
+void QueueWindowPosition(WindowState *state, int x, int y)
+{
+    g_mutex_lock(&state->pendingLock);
+    gboolean collapsed = state->pending.position;
+    state->pending.position = TRUE;
+    state->pending.x = x;
+    state->pending.y = y;
+    scheduleGeometryLocked(state, collapsed);
+    g_mutex_unlock(&state->pendingLock);
+}
+
+void QueueWindowSize(WindowState *state, int width, int height)
+{
+    g_mutex_lock(&state->pendingLock);
+    gboolean collapsed = state->pending.size;
+    state->pending.size = TRUE;
+    state->pending.width = width;
+    state->pending.height = height;
+    scheduleGeometryLocked(state, collapsed);
+    g_mutex_unlock(&state->pendingLock);
+}
+
+void QueueWindowSizeHints(WindowState *state, int minWidth, int minHeight, int maxWidth, int maxHeight)
+{
+    g_mutex_lock(&state->pendingLock);
+    gboolean collapsed = state->pending.sizeHints;
+    state->pending.sizeHints = TRUE;
+    state->pending.minWidth = minWidth;
+    state->pending.minHeight = minHeight;
+    state->pending.maxWidth = maxWidth;
+    state->pending.maxHeight = maxHeight;
+    scheduleGeometryLocked(state, collapsed);
+    g_mutex_unlock(&state->pendingLock);
+}
+
 // function to disable the context menu but propagate the event
 static gboolean disableContextMenu(GtkWidget *widget, WebKitContextMenu *context_menu, GdkEvent *event, WebKitHitTestResult *hit_test_result, gpointer data)
 {
@@ -258,15 +505,15 @@ void DisableContextMenu(void *webview)
     g_signal_connect(WEBKIT_WEB_VIEW(webview), "context-menu", G_CALLBACK(disableContextMenu), NULL);
 }
 
-static gboolean buttonPress(GtkWidget *widget, GdkEventButton *event, void *dummy)
+static gboolean buttonPress(GtkWidget *widget, GdkEventButton *event, WindowState *state)
 {
     if (event == NULL)
     {
-        xroot = yroot = 0.0f;
-        dragTime = -1;
+        state->xroot = state->yroot = 0.0;
+        state->dragTime = -1;
         return FALSE;
     }
-    mouseButton = event->button;
+    state->mouseButton = event->button;
     if (event->button == 3)
     {
         return FALSE;
@@ -274,28 +521,131 @@ static gboolean buttonPress(GtkWidget *widget, GdkEventButton *event, void *dumm
 
     if (event->type == GDK_BUTTON_PRESS && event->button == 1)
     {
-        xroot = event->x_root;
-        yroot = event->y_root;
-        dragTime = event->time;
+        state->xroot = event->x_root;
+        state->yroot = event->y_root;
+        state->dragTime = event->time;
     }
 
     return FALSE;
 }
 
-static gboolean buttonRelease(GtkWidget *widget, GdkEventButton *event, void *dummy)
+static gboolean buttonRelease(GtkWidget *widget, GdkEventButton *event, WindowState *state)
 {
     if (event == NULL || (event->type == GDK_BUTTON_RELEASE && event->button == 1))
     {
-        xroot = yroot = 0.0f;
-        dragTime = -1;
+        state->xroot = state->yroot = 0.0;
+        state->dragTime = -1;
     }
     return FALSE;
 }
 
-void ConnectButtons(void *webview)
+void ConnectButtons(WindowState *state, void *webview)
 {
-    g_signal_connect(WEBKIT_WEB_VIEW(webview), "button-press-event", G_CALLBACK(buttonPress), NULL);
-    g_signal_connect(WEBKIT_WEB_VIEW(webview), "button-release-event", G_CALLBACK(buttonRelease), NULL);
+    state->webview = webview;
+    g_signal_connect(WEBKIT_WEB_VIEW(webview), "button-press-event", G_CALLBACK(buttonPress), state);
+    g_signal_connect(WEBKIT_WEB_VIEW(webview), "button-release-event", G_CALLBACK(buttonRelease), state);
+}
+
+extern void windowGeometryChanged(WindowState *state);
+
+// Must be called on the main thread
+void UpdateWindowGeometry(WindowState *state)
+{
+    WindowGeometry geometry;
+    gtk_window_get_position(state->window, &geometry.x, &geometry.y);
+    gtk_window_get_size(state->window, &geometry.width, &geometry.height);
+    GdkWindow *gdkwindow = gtk_widget_get_window(GTK_WIDGET(state->window));
+    geometry.state = gdkwindow != NULL ? gdk_window_get_state(gdkwindow) : 0;
+
+    if (memcmp(&geometry, &state->geometry, sizeof(WindowGeometry)) == 0)
+    {
+        return;
+    }
+    UpdateWindowMonitor(state);
+
+    // Seqlock write, there's only one writer: the main thread
+    guint sequence = state->sequence;
+    __atomic_store_n(&state->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&state->geometry.x, geometry.x, __ATOMIC_RELAXED);
+    __atomic_store_n(&state->geometry.y, geometry.y, __ATOMIC_RELAXED);
+    __atomic_store_n(&state->geometry.width, geometry.width, __ATOMIC_RELAXED);
+    __atomic_store_n(&state->geometry.height, geometry.height, __ATOMIC_RELAXED);
+    __atomic_store_n(&state->geometry.state, geometry.state, __ATOMIC_RELAXED);
+    __atomic_store_n(&state->sequence, sequence + 2, __ATOMIC_RELEASE);
+
+    if (g_atomic_int_get(&state->notifyChanges))
+    {
+        windowGeometryChanged(state);
+    }
+}
+
+// Must be called on the main thread
+void UpdateWindowMonitor(WindowState *state)
+{
+    GdkWindow *gdkwindow = gtk_widget_get_window(GTK_WIDGET(state->window));
+    GdkMonitor *monitor = NULL;
+    if (gdkwindow != NULL)
+    {
+        monitor = gdk_display_get_monitor_at_window(gdk_window_get_display(gdkwindow), gdkwindow);
+    }
+    if (monitor == state->monitor)
+    {
+        return;
+    }
+
+    if (monitor != NULL)
+    {
+        g_object_ref(monitor);
+    }
+    GdkMonitor *previous = __atomic_exchange_n(&state->monitor, monitor, __ATOMIC_RELEASE);
+    if (previous != NULL)
+    {
+        g_object_unref(previous);
+    }
+}
+
+// Can be called from any thread, it never waits for the main thread
+void ReadWindowGeometry(WindowState *state, WindowGeometry *geometry)
+{
+    guint before, after;
+    do
+    {
+        before = __atomic_load_n(&state->sequence, __ATOMIC_ACQUIRE);
+        geometry->x = __atomic_load_n(&state->geometry.x, __ATOMIC_RELAXED);
+        geometry->y = __atomic_load_n(&state->geometry.y, __ATOMIC_RELAXED);
+        geometry->width = __atomic_load_n(&state->geometry.width, __ATOMIC_RELAXED);
+        geometry->height = __atomic_load_n(&state->geometry.height, __ATOMIC_RELAXED);
+        geometry->state = __atomic_load_n(&state->geometry.state, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&state->sequence, __ATOMIC_RELAXED);
+    } while ((before & 1) || before != after);
+}
+
+static gboolean windowConfigure(GtkWidget *widget, GdkEvent *event, WindowState *state)
+{
+    UpdateWindowGeometry(state);
+    return FALSE;
+}
+
+static void windowSizeAllocate(GtkWidget *widget, GdkRectangle *allocation, WindowState *state)
+{
+    UpdateWindowGeometry(state);
+}
+
+static void windowMap(GtkWidget *widget, WindowState *state)
+{
+    UpdateWindowGeometry(state);
+}
+
+void ConnectWindowGeometry(WindowState *state)
+{
+    // Connected after the default handlers, so the window has already processed the new geometry
+    g_signal_connect_after(state->window, "configure-event", G_CALLBACK(windowConfigure), state);
+    g_signal_connect_after(state->window, "window-state-event", G_CALLBACK(windowConfigure), state);
+    g_signal_connect_after(state->window, "size-allocate", G_CALLBACK(windowSizeAllocate), state);
+    g_signal_connect_after(state->window, "map", G_CALLBACK(windowMap), state);
+    UpdateWindowGeometry(state);
 }
 
 int IsFullscreen(GtkWidget *widget)
@@ -321,7 +671,11 @@ int IsMinimised(GtkWidget *widget)
 
 gboolean Center(gpointer data)
 {
-    GtkWindow *window = (GtkWindow *)data;
+    WindowState *state = (WindowState *)data;
+    GtkWindow *window = state->window;
+
+    // Center the window with the size it has been given before
+    applyPendingGeometry(state);
 
     // Get the geometry of the monitor
     GdkRectangle m = getCurrentMonitorGeometry(window);
@@ -387,7 +741,11 @@ gboolean UnMinimise(gpointer data)
 
 gboolean Fullscreen(gpointer data)
 {
-    GtkWindow *window = (GtkWindow *)data;
+    WindowState *state = (WindowState *)data;
+    GtkWindow *window = state->window;
+
+    // Mutations that were made before must not be applied to the fullscreen window
+    applyPendingGeometry(state);
 
     // Get the geometry of the monitor.
     GdkRectangle m = getCurrentMonitorGeometry(window);
@@ -397,6 +755,7 @@ gboolean Fullscreen(gpointer data)
     }
     int scale = getCurrentMonitorScaleFactor(window);
     SetMinMaxSize(window, 0, 0, m.width * scale, m.height * scale);
+    state->fullscreen = TRUE;
 
     gtk_window_fullscreen(window);
 
@@ -405,7 +764,13 @@ gboolean Fullscreen(gpointer data)
 
 gboolean UnFullscreen(gpointer data)
 {
-    gtk_window_unfullscreen((GtkWindow *)data);
+    WindowState *state = (WindowState *)data;
+
+    applyPendingGeometry(state);
+    state->fullscreen = FALSE;
+    gtk_window_unfullscreen(state->window);
+    // Apply the size hints that have been held back while the window was fullscreen
+    applyPendingGeometry(state);
 
     return G_SOURCE_REMOVE;
 }
@@ -483,57 +848,58 @@ void LoadIndex(void *webview, char *url)
     webkit_web_view_load_uri(WEBKIT_WEB_VIEW(webview), url);
 }
 
-static gboolean startDrag(gpointer data)
+static const struct
 {
-    DragOptions *options = (DragOptions *)data;
-
-    // Ignore non-toplevel widgets
-    GtkWidget *window = gtk_widget_get_toplevel(GTK_WIDGET(options->webview));
-    if (!GTK_IS_WINDOW(window))
+    const char *name;
+    GdkWindowEdge edge;
+} resizeEdges[] = {
+    {"n-resize", GDK_WINDOW_EDGE_NORTH},
+    {"ne-resize", GDK_WINDOW_EDGE_NORTH_EAST},
+    {"e-resize", GDK_WINDOW_EDGE_EAST},
+    {"se-resize", GDK_WINDOW_EDGE_SOUTH_EAST},
+    {"s-resize", GDK_WINDOW_EDGE_SOUTH},
+    {"sw-resize", GDK_WINDOW_EDGE_SOUTH_WEST},
+    {"w-resize", GDK_WINDOW_EDGE_WEST},
+    {"nw-resize", GDK_WINDOW_EDGE_NORTH_WEST},
+};
+
+// Returns TRUE if the message has been handled and must not be forwarded to Go
+static gboolean handleWindowMessage(WindowState *state, const char *message)
+{
+    gboolean drag = strcmp(message, "drag") == 0;
+    if (!drag && strncmp(message, "resize:", 7) != 0)
     {
-        free(data);
-        return G_SOURCE_REMOVE;
+        return FALSE;
     }
 
-    gtk_window_begin_move_drag(options->mainwindow, mouseButton, xroot, yroot, dragTime);
-    free(data);
-
-    return G_SOURCE_REMOVE;
-}
-
-void StartDrag(void *webview, GtkWindow *mainwindow)
-{
-    DragOptions *data = malloc(sizeof(DragOptions));
-    data->webview = webview;
-    data->mainwindow = mainwindow;
-    ExecuteOnMainThread(startDrag, (gpointer)data);
-}
-
-static gboolean startResize(gpointer data)
-{
-    ResizeOptions *options = (ResizeOptions *)data;
-
-    // Ignore non-toplevel widgets
-    GtkWidget *window = gtk_widget_get_toplevel(GTK_WIDGET(options->webview));
+    // Ignore windows in fullscreen, non-toplevel widgets and messages after the button has already been released
+    if (state->dragTime < 0 || IsFullscreen(GTK_WIDGET(state->window)))
+    {
+        return TRUE;
+    }
+    GtkWidget *window = gtk_widget_get_toplevel(GTK_WIDGET(state->webview));
     if (!GTK_IS_WINDOW(window))
     {
-        free(data);
-        return G_SOURCE_REMOVE;
+        return TRUE;
     }
 
-    gtk_window_begin_resize_drag(options->mainwindow, options->edge, mouseButton, xroot, yroot, dragTime);
-    free(data);
-
-    return G_SOURCE_REMOVE;
-}
+    if (drag)
+    {
+        gtk_window_begin_move_drag(state->window, state->mouseButton, state->xroot, state->yroot, state->dragTime);
+        return TRUE;
+    }
 
-void StartResize(void *webview, GtkWindow *mainwindow, GdkWindowEdge edge)
-{
-    ResizeOptions *data = malloc(sizeof(ResizeOptions));
-    data->webview = webview;
-    data->mainwindow = mainwindow;
-    data->edge = edge;
-    ExecuteOnMainThread(startResize, (gpointer)data);
+    const char *edge = message + 7;
+    for (size_t i = 0; i < G_N_ELEMENTS(resizeEdges); i++)
+    {
+        if (strcmp(edge, resizeEdges[i].name) == 0)
+        {
+            gtk_window_begin_resize_drag(state->window, resizeEdges[i].edge, state->mouseButton, state->xroot, state->yroot, state->dragTime);
+            return TRUE;
+        }
+    }
+    g_warning("unknown resize edge: %s", edge);
+    return TRUE;
 }
 
 void ExecuteJS(void *data)
@@ -543,8 +909,36 @@ void ExecuteJS(void *data)
     free(js->script);
 }
 
-void extern processMessageDialogResult(char *);
+void extern processMessageDialogResult(guintptr, char *);
 
+static void messageDialogResponse(GtkDialog *dialog, gint response, gpointer data)
+{
+    guintptr requestID = (guintptr)data;
+    if (response == GTK_RESPONSE_YES)
+    {
+        processMessageDialogResult(requestID, "Yes");
+    }
+    else if (response == GTK_RESPONSE_NO)
+    {
+        processMessageDialogResult(requestID, "No");
+    }
+    else if (response == GTK_RESPONSE_OK)
+    {
+        processMessageDialogResult(requestID, "OK");
+    }
+    else if (response == GTK_RESPONSE_CANCEL)
+    {
+        processMessageDialogResult(requestID, "Cancel");
+    }
+    else
+    {
+        processMessageDialogResult(requestID, "");
+    }
+
+    gtk_widget_destroy(GTK_WIDGET(dialog));
+}
+
+// MessageDialog shows the dialog and returns right away, the result is delivered to processMessageDialogResult
 void MessageDialog(void *data)
 {
     GtkDialogFlags flags;
@@ -573,39 +967,19 @@ void MessageDialog(void *data)
 
     GtkWidget *dialog;
     dialog = gtk_message_dialog_new(GTK_WINDOW(options->window),
-                                    GTK_DIALOG_DESTROY_WITH_PARENT,
+                                    GTK_DIALOG_DESTROY_WITH_PARENT | GTK_DIALOG_MODAL,
                                     messageType,
                                     flags,
                                     options->message, NULL);
     gtk_window_set_title(GTK_WINDOW(dialog), options->title);
-    GtkResponseType result = gtk_dialog_run(GTK_DIALOG(dialog));
-    if (result == GTK_RESPONSE_YES)
-    {
-        processMessageDialogResult("Yes");
-    }
-    else if (result == GTK_RESPONSE_NO)
-    {
-        processMessageDialogResult("No");
-    }
-    else if (result == GTK_RESPONSE_OK)
-    {
-        processMessageDialogResult("OK");
-    }
-    else if (result == GTK_RESPONSE_CANCEL)
-    {
-        processMessageDialogResult("Cancel");
-    }
-    else
-    {
-        processMessageDialogResult("");
-    }
+    g_signal_connect(dialog, "response", G_CALLBACK(messageDialogResponse), (gpointer)options->requestID);
+    gtk_widget_show(dialog);
 
-    gtk_widget_destroy(dialog);
     free(options->title);
     free(options->message);
 }
 
-void extern processOpenFileResult(void *);
+void extern processOpenFileResult(guintptr, char **, int);
 
 GtkFileFilter **AllocFileFilterArray(size_t ln)
 {
@@ -617,6 +991,53 @@ void freeFileFilterArray(GtkFileFilter **filters)
     free(filters);
 }
 
+typedef struct OpenFileDialogRequest
+{
+    guintptr requestID;
+    GtkFileFilter **filters;
+} OpenFileDialogRequest;
+
+static void openFileDialogResponse(GtkNativeDialog *dialog, gint response, gpointer data)
+{
+    OpenFileDialogRequest *request = (OpenFileDialogRequest *)data;
+
+    if (response == GTK_RESPONSE_ACCEPT)
+    {
+        GSList *filenames = gtk_file_chooser_get_filenames(GTK_FILE_CHOOSER(dialog));
+        guint count = g_slist_length(filenames);
+        char **result = g_new(char *, count);
+        int resultIndex = 0;
+        for (GSList *iter = filenames; iter != NULL; iter = g_slist_next(iter))
+        {
+            result[resultIndex++] = (char *)iter->data;
+        }
+        processOpenFileResult(request->requestID, result, resultIndex);
+        g_free(result);
+        g_slist_free_full(filenames, g_free);
+    }
+    else
+    {
+        processOpenFileResult(request->requestID, NULL, 0);
+    }
+
+    // Release filters
+    if (request->filters != NULL)
+    {
+        int index = 0;
+        GtkFileFilter *thisFilter;
+        while (request->filters[index] != 0)
+        {
+            thisFilter = request->filters[index];
+            g_object_unref(thisFilter);
+            index++;
+        }
+        freeFileFilterArray(request->filters);
+    }
+    free(request);
+    g_object_unref(dialog);
+}
+
+// Opendialog shows the dialog and returns right away, the result is delivered to processOpenFileResult
 void Opendialog(void *data)
 {
     struct OpenFileDialogOptions *options = data;
@@ -625,12 +1046,10 @@ void Opendialog(void *data)
     {
         label = "_Save";
     }
-    GtkWidget *dlgWidget = gtk_file_chooser_dialog_new(options->title, options->window, options->action,
-                                                       "_Cancel", GTK_RESPONSE_CANCEL,
-                                                       label, GTK_RESPONSE_ACCEPT,
-                                                       NULL);
+    GtkFileChooserNative *dialog = gtk_file_chooser_native_new(options->title, options->window, options->action,
+                                                               label, "_Cancel");
 
-    GtkFileChooser *fc = GTK_FILE_CHOOSER(dlgWidget);
+    GtkFileChooser *fc = GTK_FILE_CHOOSER(dialog);
     // filters
     if (options->filters != 0)
     {
@@ -675,53 +1094,13 @@ void Opendialog(void *data)
         }
     }
 
-    gint response = gtk_dialog_run(GTK_DIALOG(dlgWidget));
-
-    // Max 1024 files to select
-    char **result = calloc(1024, sizeof(char *));
-    int resultIndex = 0;
-
-    if (response == GTK_RESPONSE_ACCEPT)
-    {
-        GSList *filenames = gtk_file_chooser_get_filenames(fc);
-        GSList *iter = filenames;
-        while (iter)
-        {
-            result[resultIndex++] = (char *)iter->data;
-            iter = g_slist_next(iter);
-            if (resultIndex == 1024)
-            {
-                break;
-            }
-        }
-        processOpenFileResult(result);
-        iter = filenames;
-        while (iter)
-        {
-            g_free(iter->data);
-            iter = g_slist_next(iter);
-        }
-    }
-    else
-    {
-        processOpenFileResult(result);
-    }
-    free(result);
+    OpenFileDialogRequest *request = malloc(sizeof(OpenFileDialogRequest));
+    request->requestID = options->requestID;
+    request->filters = options->filters;
+    g_signal_connect(dialog, "response", G_CALLBACK(openFileDialogResponse), request);
 
-    // Release filters
-    if (options->filters != NULL)
-    {
-        int index = 0;
-        GtkFileFilter *thisFilter;
-        while (options->filters[index] != 0)
-        {
-            thisFilter = options->filters[index];
-            g_object_unref(thisFilter);
-            index++;
-        }
-        freeFileFilterArray(options->filters);
-    }
-    gtk_widget_destroy(dlgWidget);
+    gtk_native_dialog_set_modal(GTK_NATIVE_DIALOG(dialog), TRUE);
+    gtk_native_dialog_show(GTK_NATIVE_DIALOG(dialog));
     free(options->title);
 }
 
@@ -22,6 +22,8 @@ import (
 	"log"
 	"strings"
 	"sync"
+	"sync/atomic"
+	"time"
 	"unsafe"
 
 	"github.com/wailsapp/wails/v2/internal/frontend"
@@ -42,13 +44,17 @@ type Window struct {
 	debug                                    bool
 	devtoolsEnabled                          bool
 	gtkWindow                                unsafe.Pointer
+	windowState                              *C.WindowState
 	contentManager                           unsafe.Pointer
 	webview                                  unsafe.Pointer
 	applicationMenu                          *menu.Menu
 	menubar                                  *C.GtkWidget
+	menuNodes                                []*menuNode
 	webviewBox                               *C.GtkWidget
 	vbox                                     *C.GtkWidget
 	accels                                   *C.GtkAccelGroup
+	invokeWithReply                          bool
+	loadStart                                time.Time
 	minWidth, minHeight, maxWidth, maxHeight int
 }
 
@@ -88,7 +94,14 @@ func NewWindow(appoptions *options.App, debug bool, devtoolsEnabled bool) *Windo
 	external := C.CString("external")
 	defer C.free(unsafe.Pointer(external))
 	C.webkit_user_content_manager_register_script_message_handler(result.cWebKitUserContentManager(), external)
-	C.SetupInvokeSignal(result.contentManager)
+	result.windowState = C.NewWindowState(result.asGTKWindow())
+	C.SetupInvokeSignal(result.contentManager, result.windowState)
+	result.invokeWithReply = result.setupInvokeWithReply()
+	if appoptions.Linux != nil && appoptions.Linux.OnBinaryMessage != nil {
+		if C.SetupBinaryInvokeSignal(result.contentManager) == 0 {
+			log.Println("Binary messages need at least WebKit2GTK 2.38, OnBinaryMessage will not be called")
+		}
+	}
 
 	var webviewGpuPolicy int
 	if appoptions.Linux != nil {
@@ -105,9 +118,7 @@ func NewWindow(appoptions *options.App, debug bool, devtoolsEnabled bool) *Windo
 		C.int(webviewGpuPolicy),
 	)
 	result.webview = unsafe.Pointer(webview)
-	buttonPressedName := C.CString("button-press-event")
-	defer C.free(unsafe.Pointer(buttonPressedName))
-	C.ConnectButtons(unsafe.Pointer(webview))
+	C.ConnectButtons(result.windowState, unsafe.Pointer(webview))
 
 	if devtoolsEnabled {
 		C.DevtoolsEnabled(unsafe.Pointer(webview), C.int(1), C.bool(debug && appoptions.Debug.OpenInspectorOnStartup))
@@ -140,6 +151,9 @@ func NewWindow(appoptions *options.App, debug bool, devtoolsEnabled bool) *Windo
 		}
 	}
 
+	C.ConnectWindowGeometry(result.windowState)
+	initScreenTopology()
+
 	// Menu
 	result.SetApplicationMenu(appoptions.Menu)
 
@@ -163,14 +177,14 @@ func (w *Window) cWebKitUserContentManager() *C.WebKitUserContentManager {
 }
 
 func (w *Window) Fullscreen() {
-	C.ExecuteOnMainThread(C.Fullscreen, C.gpointer(w.asGTKWindow()))
+	C.ExecuteOnMainThread(C.Fullscreen, C.gpointer(w.windowState))
 }
 
 func (w *Window) UnFullscreen() {
 	if !w.IsFullScreen() {
 		return
 	}
-	C.ExecuteOnMainThread(C.UnFullscreen, C.gpointer(w.asGTKWindow()))
+	C.ExecuteOnMainThread(C.UnFullscreen, C.gpointer(w.windowState))
 	w.SetMinSize(w.minWidth, w.minHeight)
 	w.SetMaxSize(w.maxWidth, w.maxHeight)
 }
@@ -185,53 +199,82 @@ func (w *Window) Close() {
 }
 
 func (w *Window) Center() {
-	C.ExecuteOnMainThread(C.Center, C.gpointer(w.asGTKWindow()))
+	C.ExecuteOnMainThread(C.Center, C.gpointer(w.windowState))
 }
 
 func (w *Window) SetPosition(x int, y int) {
-	invokeOnMainThread(func() {
-		C.SetPosition(unsafe.Pointer(w.asGTKWindow()), C.int(x), C.int(y))
-	})
+	C.QueueWindowPosition(w.windowState, C.int(x), C.int(y))
+}
+
+// geometry returns the last geometry published by the main thread without waiting for it
+func (w *Window) geometry() C.WindowGeometry {
+	var geometry C.WindowGeometry
+	C.ReadWindowGeometry(w.windowState, &geometry)
+	return geometry
+}
+
+// windowGeometryListeners maps the WindowState of a window to the channel that is signalled after its geometry changed
+var windowGeometryListeners sync.Map
+
+// NotifyGeometryChanges returns a channel that is signalled after the geometry or state of the window changed.
+// Changes are coalesced, a signal only tells that the geometry needs to be read again.
+func (w *Window) NotifyGeometryChanges() <-chan struct{} {
+	changed := make(chan struct{}, 1)
+	windowGeometryListeners.Store(w.windowState, changed)
+	atomic.StoreInt32((*int32)(unsafe.Pointer(&w.windowState.notifyChanges)), 1)
+	return changed
+}
+
+//export windowGeometryChanged
+func windowGeometryChanged(state *C.WindowState) {
+	if changed, ok := windowGeometryListeners.Load(state); ok {
+		select {
+		case changed.(chan struct{}) <- struct{}{}:
+		default:
+		}
+	}
+}
+
+// WindowGeometryStats are the counters of the geometry command buffer of a window
+type WindowGeometryStats struct {
+	// Queued is the number of position, size and size hint mutations
+	Queued uint64
+	// Applied is the number of mutations that have been applied to the window
+	Applied uint64
+	// Collapsed is the number of mutations that have been superseded by a newer one before they were applied
+	Collapsed uint64
+}
+
+// GeometryStats returns a snapshot of the counters of the geometry command buffer. Position, size and size hint
+// mutations are buffered and only the latest of each is applied once per frame.
+func (w *Window) GeometryStats() WindowGeometryStats {
+	return WindowGeometryStats{
+		Queued:    atomic.LoadUint64((*uint64)(unsafe.Pointer(&w.windowState.geometryQueued))),
+		Applied:   atomic.LoadUint64((*uint64)(unsafe.Pointer(&w.windowState.geometryApplied))),
+		Collapsed: atomic.LoadUint64((*uint64)(unsafe.Pointer(&w.windowState.geometryCollapsed))),
+	}
 }
 
 func (w *Window) Size() (int, int) {
-	var width, height C.int
-	var wg sync.WaitGroup
-	wg.Add(1)
-	invokeOnMainThread(func() {
-		C.gtk_window_get_size(w.asGTKWindow(), &width, &height)
-		wg.Done()
-	})
-	wg.Wait()
-	return int(width), int(height)
+	geometry := w.geometry()
+	return int(geometry.width), int(geometry.height)
 }
 
 func (w *Window) GetPosition() (int, int) {
-	var width, height C.int
-	var wg sync.WaitGroup
-	wg.Add(1)
-	invokeOnMainThread(func() {
-		C.gtk_window_get_position(w.asGTKWindow(), &width, &height)
-		wg.Done()
-	})
-	wg.Wait()
-	return int(width), int(height)
+	geometry := w.geometry()
+	return int(geometry.x), int(geometry.y)
 }
 
 func (w *Window) SetMaxSize(maxWidth int, maxHeight int) {
 	w.maxHeight = maxHeight
 	w.maxWidth = maxWidth
-	invokeOnMainThread(func() {
-		C.SetMinMaxSize(w.asGTKWindow(), C.int(w.minWidth), C.int(w.minHeight), C.int(w.maxWidth), C.int(w.maxHeight))
-	})
+	C.QueueWindowSizeHints(w.windowState, C.int(w.minWidth), C.int(w.minHeight), C.int(w.maxWidth), C.int(w.maxHeight))
 }
 
 func (w *Window) SetMinSize(minWidth int, minHeight int) {
 	w.minHeight = minHeight
 	w.minWidth = minWidth
-	invokeOnMainThread(func() {
-		C.SetMinMaxSize(w.asGTKWindow(), C.int(w.minWidth), C.int(w.minHeight), C.int(w.maxWidth), C.int(w.maxHeight))
-	})
+	C.QueueWindowSizeHints(w.windowState, C.int(w.minWidth), C.int(w.minHeight), C.int(w.maxWidth), C.int(w.maxHeight))
 }
 
 func (w *Window) Show() {
@@ -259,21 +302,16 @@ func (w *Window) UnMinimise() {
 }
 
 func (w *Window) IsFullScreen() bool {
-	result := C.IsFullscreen(w.asGTKWidget())
-	if result != 0 {
-		return true
-	}
-	return false
+	return w.geometry().state&C.GDK_WINDOW_STATE_FULLSCREEN != 0
 }
 
 func (w *Window) IsMaximised() bool {
-	result := C.IsMaximised(w.asGTKWidget())
-	return result > 0
+	state := w.geometry().state
+	return state&C.GDK_WINDOW_STATE_MAXIMIZED != 0 && state&C.GDK_WINDOW_STATE_FULLSCREEN == 0
 }
 
 func (w *Window) IsMinimised() bool {
-	result := C.IsMinimised(w.asGTKWidget())
-	return result > 0
+	return w.geometry().state&C.GDK_WINDOW_STATE_ICONIFIED != 0
 }
 
 func (w *Window) IsNormal() bool {
@@ -305,6 +343,15 @@ func (w *Window) SetWindowIcon(icon []byte) {
 	C.SetWindowIcon(w.asGTKWindow(), (*C.guchar)(&icon[0]), (C.gsize)(len(icon)))
 }
 
+// Load starts loading the url, which spawns the web process. It's called before Run so the web process starts
+// while the rest of the app is initialised.
+func (w *Window) Load(url string) {
+	w.loadStart = time.Now()
+	_url := C.CString(url)
+	C.LoadIndex(w.webview, _url)
+	C.free(unsafe.Pointer(_url))
+}
+
 func (w *Window) Run(url string) {
 	if w.menubar != nil {
 		C.gtk_box_pack_start(C.GTKBOX(unsafe.Pointer(w.vbox)), w.menubar, 0, 0, 0)
@@ -312,9 +359,9 @@ func (w *Window) Run(url string) {
 
 	C.gtk_box_pack_start(C.GTKBOX(unsafe.Pointer(w.webviewBox)), C.GTKWIDGET(w.webview), 1, 1, 0)
 	C.gtk_box_pack_start(C.GTKBOX(unsafe.Pointer(w.vbox)), w.webviewBox, 1, 1, 0)
-	_url := C.CString(url)
-	C.LoadIndex(w.webview, _url)
-	defer C.free(unsafe.Pointer(_url))
+	if w.loadStart.IsZero() {
+		w.Load(url)
+	}
 	if w.appoptions.StartHidden {
 		w.Hide()
 	}
@@ -340,10 +387,11 @@ func (w *Window) SetResizable(resizable bool) {
 
 func (w *Window) SetDefaultSize(width int, height int) {
 	C.gtk_window_set_default_size(w.asGTKWindow(), C.int(width), C.int(height))
+	C.UpdateWindowGeometry(w.windowState)
 }
 
 func (w *Window) SetSize(width int, height int) {
-	C.gtk_window_resize(w.asGTKWindow(), C.gint(width), C.gint(height))
+	C.QueueWindowSize(w.windowState, C.int(width), C.int(height))
 }
 
 func (w *Window) SetDecorated(frameless bool) {
@@ -362,21 +410,33 @@ func (w *Window) ExecJS(js string) {
 	invokeOnMainThread(func() { C.ExecuteJS(unsafe.Pointer(&jscallback)) })
 }
 
-func (w *Window) StartDrag() {
-	C.StartDrag(w.webview, w.asGTKWindow())
-}
-
-func (w *Window) StartResize(edge uintptr) {
-	C.StartResize(w.webview, w.asGTKWindow(), C.GdkWindowEdge(edge))
+// ReplyToMessage resolves the promise of a message posted to the `externalWithReply` handler with the json, or
+// rejects it if err is not nil.
+func (w *Window) ReplyToMessage(reply unsafe.Pointer, json string, err error) {
+	invokeOnMainThread(func() {
+		var cJSON, cError *C.char
+		if err != nil {
+			cError = C.CString(err.Error())
+			defer C.free(unsafe.Pointer(cError))
+		} else {
+			cJSON = C.CString(json)
+			defer C.free(unsafe.Pointer(cJSON))
+		}
+		C.ReplyToMessage(reply, cJSON, cError)
+	})
 }
 
 func (w *Window) Quit() {
 	C.gtk_main_quit()
 }
 
-func (w *Window) OpenFileDialog(dialogOptions frontend.OpenDialogOptions, multipleFiles int, action C.GtkFileChooserAction) {
+// OpenFileDialog shows the dialog without blocking the main loop, the selected files are delivered to the returned
+// channel.
+func (w *Window) OpenFileDialog(dialogOptions frontend.OpenDialogOptions, multipleFiles int, action C.GtkFileChooserAction) <-chan []string {
+	requestID, result := openFileResults.add()
 
 	data := C.OpenFileDialogOptions{
+		requestID:     C.guintptr(requestID),
 		window:        w.asGTKWindow(),
 		title:         C.CString(dialogOptions.Title),
 		multipleFiles: C.int(multipleFiles),
@@ -426,14 +486,19 @@ func (w *Window) OpenFileDialog(dialogOptions frontend.OpenDialogOptions, multip
 	}
 
 	invokeOnMainThread(func() { C.Opendialog(unsafe.Pointer(&data)) })
+	return result
 }
 
-func (w *Window) MessageDialog(dialogOptions frontend.MessageDialogOptions) {
+// MessageDialog shows the dialog without blocking the main loop, the clicked button is delivered to the returned
+// channel.
+func (w *Window) MessageDialog(dialogOptions frontend.MessageDialogOptions) <-chan string {
+	requestID, result := messageDialogResults.add()
 
 	data := C.MessageDialogOptions{
-		window:  w.gtkWindow,
-		title:   C.CString(dialogOptions.Title),
-		message: C.CString(dialogOptions.Message),
+		requestID: C.guintptr(requestID),
+		window:    w.gtkWindow,
+		title:     C.CString(dialogOptions.Title),
+		message:   C.CString(dialogOptions.Message),
 	}
 	switch dialogOptions.Type {
 	case frontend.InfoDialog:
@@ -446,6 +511,7 @@ func (w *Window) MessageDialog(dialogOptions frontend.MessageDialogOptions) {
 		data.messageType = C.int(3)
 	}
 	invokeOnMainThread(func() { C.MessageDialog(unsafe.Pointer(&data)) })
+	return result
 }
 
 func (w *Window) ToggleMaximise() {
@@ -462,16 +528,18 @@ func (w *Window) ShowInspector() {
 
 // showModalDialogAndExit shows a modal dialog and exits the app.
 func showModalDialogAndExit(title, message string) {
-	go func() {
-		data := C.MessageDialogOptions{
-			title:       C.CString(title),
-			message:     C.CString(message),
-			messageType: C.int(1),
-		}
-
-		C.MessageDialog(unsafe.Pointer(&data))
-	}()
+	requestID, result := messageDialogResults.add()
+	data := C.MessageDialogOptions{
+		requestID:   C.guintptr(requestID),
+		title:       C.CString(title),
+		message:     C.CString(message),
+		messageType: C.int(1),
+	}
+	C.MessageDialog(unsafe.Pointer(&data))
 
-	<-messageDialogResult
+	// The main loop isn't running yet, iterate it until the dialog has been closed
+	for len(result) == 0 {
+		C.gtk_main_iteration()
+	}
 	log.Fatal(message)
 }
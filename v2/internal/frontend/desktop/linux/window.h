@@ -7,19 +7,72 @@
 #include <stdio.h>
 #include <limits.h>
 #include <stdint.h>
+#include "invoke.h"
 
-typedef struct DragOptions
+// WindowGeometry is a snapshot of the position, size and GdkWindowState of a window
+typedef struct WindowGeometry
 {
-    void *webview;
-    GtkWindow *mainwindow;
-} DragOptions;
+    int x;
+    int y;
+    int width;
+    int height;
+    int state;
+} WindowGeometry;
+
+// PendingGeometry holds the latest geometry mutations of a window until the next frame clock update
+typedef struct PendingGeometry
+{
+    gboolean position;
+    int x;
+    int y;
+
+    gboolean size;
+    int width;
+    int height;
+
+    gboolean sizeHints;
+    int minWidth;
+    int minHeight;
+    int maxWidth;
+    int maxHeight;
+
+    gboolean scheduled;
+} PendingGeometry;
 
-typedef struct ResizeOptions
+// WindowState is the per window state of the native signal handlers
+typedef struct WindowState
 {
+    GtkWindow *window;
     void *webview;
-    GtkWindow *mainwindow;
-    GdkWindowEdge edge;
-} ResizeOptions;
+
+    // Mirror of the window geometry, it's written on the main thread and read from any thread with ReadWindowGeometry.
+    // The sequence is odd while the geometry is being written.
+    guint sequence;
+    WindowGeometry geometry;
+    // If set, windowGeometryChanged is called after the geometry changed
+    gint notifyChanges;
+    // The monitor the window is on, it's updated with the geometry and read atomically
+    GdkMonitor *monitor;
+
+    // Geometry mutations are buffered and applied once per frame, see QueueWindowPosition
+    GMutex pendingLock;
+    PendingGeometry pending;
+    // The update signal of the frame clock is only connected while mutations are pending
+    GdkFrameClock *frameClock;
+    gulong frameClockHandler;
+    // Set between Fullscreen and UnFullscreen, only accessed on the main thread
+    gboolean fullscreen;
+    guint64 geometryQueued;
+    guint64 geometryApplied;
+    guint64 geometryCollapsed;
+
+    // These are the x,y,time & button of the last mouse down event
+    // It's used for window dragging and resizing
+    gdouble xroot;
+    gdouble yroot;
+    gint64 dragTime;
+    guint mouseButton;
+} WindowState;
 
 typedef struct JSCallback
 {
@@ -29,6 +82,7 @@ typedef struct JSCallback
 
 typedef struct MessageDialogOptions
 {
+    guintptr requestID;
     void *window;
     char *title;
     char *message;
@@ -37,6 +91,7 @@ typedef struct MessageDialogOptions
 
 typedef struct OpenFileDialogOptions
 {
+    guintptr requestID;
     GtkWindow *window;
     char *title;
     char *defaultFilename;
@@ -65,31 +120,32 @@ typedef struct SetTitleArgs
     char *title;
 } SetTitleArgs;
 
-typedef struct SetPositionArgs
-{
-    int x;
-    int y;
-    void *window;
-} SetPositionArgs;
-
-void ExecuteOnMainThread(void *f, gpointer jscallback);
-
 GtkWidget *GTKWIDGET(void *pointer);
 GtkWindow *GTKWINDOW(void *pointer);
 GtkContainer *GTKCONTAINER(void *pointer);
 GtkBox *GTKBOX(void *pointer);
 
 // window
-ulong SetupInvokeSignal(void *contentManager);
+WindowState *NewWindowState(GtkWindow *window);
+ulong SetupInvokeSignal(void *contentManager, WindowState *state);
+ulong SetupBinaryInvokeSignal(void *contentManager);
+ulong SetupInvokeWithReplySignal(void *contentManager);
+void ReplyToMessage(void *data, char *json, char *errorMessage);
 
 void SetWindowIcon(GtkWindow *window, const guchar *buf, gsize len);
 void SetWindowTransparency(GtkWidget *widget);
 void SetBackgroundColour(void *data);
 void SetTitle(GtkWindow *window, char *title);
-void SetPosition(void *window, int x, int y);
+void QueueWindowPosition(WindowState *state, int x, int y);
+void QueueWindowSize(WindowState *state, int width, int height);
+void QueueWindowSizeHints(WindowState *state, int minWidth, int minHeight, int maxWidth, int maxHeight);
 void SetMinMaxSize(GtkWindow *window, int min_width, int min_height, int max_width, int max_height);
 void DisableContextMenu(void *webview);
-void ConnectButtons(void *webview);
+void ConnectButtons(WindowState *state, void *webview);
+void ConnectWindowGeometry(WindowState *state);
+void UpdateWindowGeometry(WindowState *state);
+void ReadWindowGeometry(WindowState *state, WindowGeometry *geometry);
+void UpdateWindowMonitor(WindowState *state);
 
 int IsFullscreen(GtkWidget *widget);
 int IsMaximised(GtkWidget *widget);
@@ -111,10 +167,6 @@ void LoadIndex(void *webview, char *url);
 void DevtoolsEnabled(void *webview, int enabled, bool showInspector);
 void ExecuteJS(void *data);
 
-// Drag
-void StartDrag(void *webview, GtkWindow *mainwindow);
-void StartResize(void *webview, GtkWindow *mainwindow, GdkWindowEdge edge);
-
 // Dialog
 void MessageDialog(void *data);
 GtkFileFilter **AllocFileFilterArray(size_t ln);
@@ -140,6 +140,20 @@ func (d *DevWebServer) WindowReloadApp() {
 	d.Frontend.WindowReloadApp()
 }
 
+func (d *DevWebServer) ClipboardGetData(mimeType string) ([]byte, error) {
+	if clipboard, ok := d.Frontend.(frontend.ClipboardData); ok {
+		return clipboard.ClipboardGetData(mimeType)
+	}
+	return nil, frontend.ErrClipboardDataNotSupported
+}
+
+func (d *DevWebServer) ClipboardSetData(mimeTypes []string, provide func(mimeType string) []byte) error {
+	if clipboard, ok := d.Frontend.(frontend.ClipboardData); ok {
+		return clipboard.ClipboardSetData(mimeTypes, provide)
+	}
+	return frontend.ErrClipboardDataNotSupported
+}
+
 func (d *DevWebServer) Notify(name string, data ...interface{}) {
 	d.notify(name, data...)
 }
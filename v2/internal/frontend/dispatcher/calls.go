@@ -6,6 +6,7 @@ import (
 	"strings"
 
 	"github.com/wailsapp/wails/v2/internal/frontend"
+	"github.com/wailsapp/wails/v2/pkg/assetserver"
 )
 
 type callMessage struct {
@@ -45,6 +46,11 @@ func (d *Dispatcher) processCallMessage(message string, sender frontend.Frontend
 		result, err = registeredMethod.Call(args)
 	}
 
+	// Binary results are fetched by the runtime from the AssetServer instead of being marshalled into the message
+	if blob, ok := result.(*assetserver.Blob); ok && blob != nil && err == nil {
+		result, err = assetserver.RegisterBlob(blob)
+	}
+
 	callbackMessage := &CallbackMessage{
 		CallbackID: payload.CallbackID,
 	}
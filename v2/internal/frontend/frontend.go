@@ -2,6 +2,7 @@ package frontend
 
 import (
 	"context"
+	"errors"
 
 	"github.com/wailsapp/wails/v2/pkg/menu"
 	"github.com/wailsapp/wails/v2/pkg/options"
@@ -140,3 +141,12 @@ type Frontend interface {
 	ClipboardGetText() (string, error)
 	ClipboardSetText(text string) error
 }
+
+// ErrClipboardDataNotSupported is returned if the frontend doesn't implement ClipboardData
+var ErrClipboardDataNotSupported = errors.New("clipboard data is not supported on this platform")
+
+// ClipboardData is implemented by frontends that support clipboard content of arbitrary MIME types
+type ClipboardData interface {
+	ClipboardGetData(mimeType string) ([]byte, error)
+	ClipboardSetData(mimeTypes []string, provide func(mimeType string) []byte) error
+}
@@ -93,7 +93,7 @@ export function Call(name, args, timeout) {
 			};
 
             // Make the call
-            window.WailsInvoke('C' + JSON.stringify(payload));
+            invokeCall('C' + JSON.stringify(payload), callbackID);
         } catch (e) {
             // eslint-disable-next-line
             console.error(e);
@@ -140,7 +140,7 @@ window.ObfuscatedCall = (id, args, timeout) => {
 			};
 
             // Make the call
-            window.WailsInvoke('c' + JSON.stringify(payload));
+            invokeCall('c' + JSON.stringify(payload), callbackID);
         } catch (e) {
             // eslint-disable-next-line
             console.error(e);
@@ -149,6 +149,31 @@ window.ObfuscatedCall = (id, args, timeout) => {
 };
 
 
+/**
+ * Sends a call message to the backend. If the platform supports replies
+ * to messages, the result is delivered with the reply instead of a
+ * separate Callback from the backend.
+ *
+ * @param {string} message
+ * @param {string} callbackID
+ */
+function invokeCall(message, callbackID) {
+	if (!window.WailsInvokeWithReply) {
+		window.WailsInvoke(message);
+		return;
+	}
+
+	window.WailsInvokeWithReply(message).then((reply) => handleCallback(reply), (e) => {
+		let callbackData = callbacks[callbackID];
+		if (!callbackData) {
+			return;
+		}
+		clearTimeout(callbackData.timeoutHandle);
+		delete callbacks[callbackID];
+		callbackData.reject(e.message);
+	});
+}
+
 /**
  * Called by the backend to return data to a previously called
  * binding invocation
@@ -166,6 +191,15 @@ export function Callback(incomingMessage) {
 		runtime.LogDebug(error);
 		throw new Error(error);
 	}
+	handleCallback(message);
+}
+
+/**
+ * Resolves or rejects the call of a parsed callback message
+ *
+ * @param {Object} message
+ */
+function handleCallback(message) {
 	let callbackID = message.callbackid;
 	let callbackData = callbacks[callbackID];
 	if (!callbackData) {
@@ -179,7 +213,24 @@ export function Callback(incomingMessage) {
 
 	if (message.error) {
 		callbackData.reject(message.error);
+	} else if (message.result && message.result.wailsblob) {
+		fetchBlob(message.result).then(callbackData.resolve, callbackData.reject);
 	} else {
 		callbackData.resolve(message.result);
 	}
 }
+
+/**
+ * Fetches the binary result of a call from the AssetServer
+ *
+ * @param {Object} handle
+ * @returns {Promise<ArrayBuffer>}
+ */
+function fetchBlob(handle) {
+	return fetch(handle.wailsblob).then((response) => {
+		if (!response.ok) {
+			throw new Error(`Unable to fetch the result: ${response.status} ${response.statusText}`);
+		}
+		return response.arrayBuffer();
+	});
+}
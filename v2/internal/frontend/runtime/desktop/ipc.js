@@ -36,4 +36,16 @@ The electron alternative for Go
 	if (mac_linux) {
 		window.WailsInvoke = (message) => window.webkit.messageHandlers.external.postMessage(message);
 	}
+
+	// On Linux with WebKit2GTK 2.40+ call results are delivered with the reply of the message
+	let linux_reply = _deeptest(["webkit", "messageHandlers", "externalWithReply", "postMessage"]);
+	if (linux_reply) {
+		window.WailsInvokeWithReply = (message) => window.webkit.messageHandlers.externalWithReply.postMessage(message);
+	}
+
+	// Binary messages (ArrayBuffer/TypedArray) are only available on Linux when the app handles them
+	let linux_binary = _deeptest(["webkit", "messageHandlers", "externalBinary", "postMessage"]);
+	if (linux_binary) {
+		window.WailsInvokeBinary = (data) => window.webkit.messageHandlers.externalBinary.postMessage(data);
+	}
 })();
\ No newline at end of file
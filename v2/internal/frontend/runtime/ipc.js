@@ -1 +1 @@
-(()=>{(function(){let n=function(e){for(var s=window[e.shift()];s&&e.length;)s=s[e.shift()];return s},o=n(["chrome","webview","postMessage"]),t=n(["webkit","messageHandlers","external","postMessage"]);if(!o&&!t){console.error("Unsupported Platform");return}o&&(window.WailsInvoke=e=>window.chrome.webview.postMessage(e)),t&&(window.WailsInvoke=e=>window.webkit.messageHandlers.external.postMessage(e))})();})();
+(()=>{(function(){let s=function(e){for(var i=window[e.shift()];i&&e.length;)i=i[e.shift()];return i},n=s(["chrome","webview","postMessage"]),t=s(["webkit","messageHandlers","external","postMessage"]);if(!n&&!t){console.error("Unsupported Platform");return}n&&(window.WailsInvoke=e=>window.chrome.webview.postMessage(e)),t&&(window.WailsInvoke=e=>window.webkit.messageHandlers.external.postMessage(e)),s(["webkit","messageHandlers","externalWithReply","postMessage"])&&(window.WailsInvokeWithReply=e=>window.webkit.messageHandlers.externalWithReply.postMessage(e)),s(["webkit","messageHandlers","externalBinary","postMessage"])&&(window.WailsInvokeBinary=e=>window.webkit.messageHandlers.externalBinary.postMessage(e))})();})();
@@ -10,8 +10,11 @@ import (
 	"net/http"
 	"os"
 	"path"
+	"reflect"
 	"strconv"
 	"strings"
+	"sync"
+	"time"
 
 	"github.com/wailsapp/wails/v2/pkg/options/assetserver"
 )
@@ -28,9 +31,16 @@ const (
 	indexHTML = "index.html"
 )
 
+// dirFSType is the type of os.DirFS, the files of such a FS may change while the app is running
+var dirFSType = reflect.TypeOf(os.DirFS("."))
+
 type assetHandler struct {
-	fs      iofs.FS
-	handler http.Handler
+	fs       iofs.FS
+	manifest *Manifest
+	handler  http.Handler
+
+	// etags caches the ETags of embedded files that are not in the manifest or not fingerprinted
+	etags sync.Map
 
 	logger Logger
 
@@ -39,12 +49,15 @@ type assetHandler struct {
 
 func NewAssetHandler(options assetserver.Options, log Logger) (http.Handler, error) {
 	vfs := options.Assets
+	var manifest *Manifest
 	if vfs != nil {
 		if _, err := vfs.Open("."); err != nil {
 			return nil, err
 		}
 
-		subDir, err := FindPathToFile(vfs, indexHTML)
+		var subDir string
+		var err error
+		manifest, subDir, err = loadManifest(vfs, log)
 		if err != nil {
 			if errors.Is(err, os.ErrNotExist) {
 				msg := "no `index.html` could be found in your Assets fs.FS"
@@ -66,9 +79,10 @@ func NewAssetHandler(options assetserver.Options, log Logger) (http.Handler, err
 	}
 
 	var result http.Handler = &assetHandler{
-		fs:      vfs,
-		handler: options.Handler,
-		logger:  log,
+		fs:       vfs,
+		manifest: manifest,
+		handler:  options.Handler,
+		logger:   log,
 	}
 
 	if middleware := options.Middleware; middleware != nil {
@@ -110,12 +124,41 @@ func (d *assetHandler) ServeHTTP(rw http.ResponseWriter, req *http.Request) {
 	}
 }
 
+// loadManifest loads the asset manifest and returns the directory that contains `index.html`. The manifest is nil if
+// there's none or the assets are served from disk, then the directory is searched.
+func loadManifest(vfs iofs.FS, log Logger) (*Manifest, string, error) {
+	if reflect.TypeOf(vfs) != dirFSType {
+		manifest, dir, err := LoadManifest(vfs)
+		if err == nil {
+			return manifest, path.Join(dir, manifest.Root), nil
+		}
+		if !errors.Is(err, os.ErrNotExist) && log != nil {
+			log.Debug("[AssetHandler] Ignoring the asset manifest: %s", err)
+		}
+	}
+
+	subDir, err := FindPathToFile(vfs, indexHTML)
+	return nil, subDir, err
+}
+
 // serveFSFile will try to load the file from the fs.FS and write it to the response
 func (d *assetHandler) serveFSFile(rw http.ResponseWriter, req *http.Request, filename string) error {
 	if d.fs == nil {
 		return os.ErrNotExist
 	}
 
+	url := req.URL.Path
+	isDirectoryPath := url == "" || url[len(url)-1] == '/'
+	if d.manifest != nil {
+		assetPath := filename
+		if isDirectoryPath {
+			assetPath = path.Join(filename, indexHTML)
+		}
+		if entry := d.manifest.Lookup(assetPath); entry != nil {
+			return d.serveManifestFile(rw, req, entry)
+		}
+	}
+
 	file, err := d.fs.Open(filename)
 	if err != nil {
 		return err
@@ -127,8 +170,6 @@ func (d *assetHandler) serveFSFile(rw http.ResponseWriter, req *http.Request, fi
 		return err
 	}
 
-	url := req.URL.Path
-	isDirectoryPath := url == "" || url[len(url)-1] == '/'
 	if statInfo.IsDir() {
 		if !isDirectoryPath {
 			// If the URL doesn't end in a slash normally a http.redirect should be done, but that currently doesn't work on
@@ -174,7 +215,16 @@ func (d *assetHandler) serveFSFile(rw http.ResponseWriter, req *http.Request, fi
 			return fmt.Errorf("seeker can't seek")
 		}
 
-		http.ServeContent(rw, req, statInfo.Name(), statInfo.ModTime(), fileSeeker)
+		// Files of an embedded FS have no ModTime, conditional requests use their content hash instead
+		if statInfo.ModTime().IsZero() && path.Base(filename) != indexHTML {
+			etag, err := d.embeddedETag(filename, fileSeeker)
+			if err != nil {
+				return err
+			}
+			setAssetCacheHeaders(rw.Header(), filename, etag)
+		}
+
+		serveContent(rw, req, statInfo.Name(), statInfo.ModTime(), statInfo.Size(), unmappedFile(fileSeeker))
 		return nil
 	}
 
@@ -192,6 +242,102 @@ func (d *assetHandler) serveFSFile(rw http.ResponseWriter, req *http.Request, fi
 	return err
 }
 
+// serveManifestFile writes the asset of the manifest entry, without looking up its size or sniffing its MimeType
+func (d *assetHandler) serveManifestFile(rw http.ResponseWriter, req *http.Request, entry *ManifestEntry) error {
+	etag, err := d.manifestETag(entry)
+	if err != nil {
+		return err
+	}
+
+	header := rw.Header()
+	filePath, size := entry.Path, entry.Size
+
+	// index.html must stay uncompressed, the runtime gets injected into it
+	if len(entry.Variants) != 0 && path.Base(entry.Path) != indexHTML {
+		header.Add(HeaderVary, HeaderAcceptEncoding)
+		if variant := preferredVariant(req.Header.Get(HeaderAcceptEncoding), entry.Variants); variant != nil {
+			header.Set(HeaderContentEncoding, variant.Encoding)
+			filePath, size, etag = variant.Path, variant.Size, variantETag(etag, variant.Encoding)
+		}
+	}
+
+	file, err := d.fs.Open(filePath)
+	if err != nil {
+		return err
+	}
+	defer file.Close()
+
+	if _, haveType := header[HeaderContentType]; !haveType {
+		header.Set(HeaderContentType, entry.MimeType)
+	}
+	setAssetCacheHeaders(header, entry.Path, etag)
+
+	if fileSeeker, _ := file.(io.ReadSeeker); fileSeeker != nil {
+		if _, isEncoded := header[HeaderContentEncoding]; isEncoded && req.Header.Get("Range") == "" {
+			// ServeContent doesn't set the length of encoded content
+			header.Set(HeaderContentLength, strconv.FormatInt(size, 10))
+		}
+		serveContent(rw, req, entry.Path, time.Time{}, size, unmappedFile(fileSeeker))
+		return nil
+	}
+
+	if etag := header.Get(HeaderETag); etag != "" && etagMatches(req.Header.Get(HeaderIfNoneMatch), etag) {
+		rw.WriteHeader(http.StatusNotModified)
+		return nil
+	}
+
+	header.Set(HeaderContentLength, strconv.FormatInt(size, 10))
+	_, err = io.Copy(rw, file)
+	return err
+}
+
+// manifestETag returns the ETag of the asset of the manifest entry. The manifest is only validated by the sizes of the
+// assets, so the hash of an asset that keeps its name across builds might be stale. Only fingerprinted assets, whose
+// name changes with their content, use the hash of the manifest. The others are hashed on their first request.
+func (d *assetHandler) manifestETag(entry *ManifestEntry) (string, error) {
+	if isFingerprinted(entry.Path) || path.Base(entry.Path) == indexHTML {
+		return entry.ETag(), nil
+	}
+	if etag, ok := d.etags.Load(entry.Path); ok {
+		return etag.(string), nil
+	}
+
+	file, err := d.fs.Open(entry.Path)
+	if err != nil {
+		return "", err
+	}
+	defer file.Close()
+
+	fileSeeker, _ := file.(io.ReadSeeker)
+	if fileSeeker == nil {
+		return "", nil
+	}
+	return d.embeddedETag(entry.Path, fileSeeker)
+}
+
+// embeddedETag returns the ETag of a file of an embedded FS, the hash is computed on the first request
+func (d *assetHandler) embeddedETag(filename string, file io.ReadSeeker) (string, error) {
+	if etag, ok := d.etags.Load(filename); ok {
+		return etag.(string), nil
+	}
+
+	etag, err := readerETag(file)
+	if err != nil {
+		return "", err
+	}
+	d.etags.Store(filename, etag)
+	return etag, nil
+}
+
+// unmappedFile hides the *os.File of an asset from the webview, which would memory map it. Assets on disk get rewritten
+// while developing, and reading a mapping of a truncated file crashes the app.
+func unmappedFile(file io.ReadSeeker) io.ReadSeeker {
+	if _, isFile := file.(*os.File); isFile {
+		return struct{ io.ReadSeeker }{file}
+	}
+	return file
+}
+
 func (d *assetHandler) logDebug(message string, args ...interface{}) {
 	if d.logger != nil {
 		d.logger.Debug("[AssetHandler] "+message, args...)
@@ -5,6 +5,7 @@ import (
 	"fmt"
 	"math/rand"
 	"net/http"
+	"sort"
 	"strings"
 
 	"golang.org/x/net/html"
@@ -46,6 +47,11 @@ type AssetServer struct {
 
 	// plugin scripts
 	pluginScripts map[string]string
+	// pluginScriptNames are the sorted names of the plugin scripts, in the order they get injected
+	pluginScriptNames []string
+
+	// indexHTMLCache caches the index.html with the injected scripts
+	indexHTMLCache indexHTMLCache
 
 	assetServerWebView
 }
@@ -89,6 +95,12 @@ func NewAssetServerWithHandler(handler http.Handler, bindingsJSON string, servin
 		runtime:         runtime,
 	}
 
+	result.indexHTMLCache.capacity = maxCachedIndexHTML
+	if servingFromDisk {
+		// Only the current version of the files on disk is worth keeping
+		result.indexHTMLCache.capacity = 1
+	}
+
 	return result, nil
 }
 
@@ -103,6 +115,10 @@ func (d *AssetServer) AddPluginScript(pluginName string, script string) {
 	pluginName = strings.ReplaceAll(pluginName, "/", "_")
 	pluginName = html.EscapeString(pluginName)
 	pluginScriptName := fmt.Sprintf("/plugin_%s_%d.js", pluginName, rand.Intn(100000))
+	if _, exists := d.pluginScripts[pluginScriptName]; !exists {
+		d.pluginScriptNames = append(d.pluginScriptNames, pluginScriptName)
+		sort.Strings(d.pluginScriptNames)
+	}
 	d.pluginScripts[pluginScriptName] = script
 }
 
@@ -124,7 +140,9 @@ func (d *AssetServer) ServeHTTP(rw http.ResponseWriter, req *http.Request) {
 	}
 
 	path := req.URL.Path
-	if path == runtimeJSPath {
+	if strings.HasPrefix(path, blobPathPrefix) {
+		d.serveBlob(rw, path)
+	} else if path == runtimeJSPath {
 		d.writeBlob(rw, path, d.runtimeJS)
 	} else if path == runtimePath && d.runtimeHandler != nil {
 		d.runtimeHandler.HandleRuntimeCall(rw, req)
@@ -138,18 +156,25 @@ func (d *AssetServer) ServeHTTP(rw http.ResponseWriter, req *http.Request) {
 	} else if script, ok := d.pluginScripts[path]; ok {
 		d.writeBlob(rw, path, []byte(script))
 	} else if d.isRuntimeInjectionMatch(path) {
+		injector := &scriptInjector{ResponseWriter: rw}
 		recorder := &bodyRecorder{
-			ResponseWriter: rw,
+			ResponseWriter: injector,
 			doRecord: func(code int, h http.Header) bool {
 				if code == http.StatusNotFound {
 					return true
 				}
 
-				if code != http.StatusOK {
+				if code != http.StatusOK || !strings.Contains(h.Get(HeaderContentType), "text/html") {
 					return false
 				}
 
-				return strings.Contains(h.Get(HeaderContentType), "text/html")
+				// Documents of a known length, like the index.html of the assets, are processed as a whole and cached.
+				// Generated documents are streamed with the scripts injected on the fly.
+				if _, hasLength := h[HeaderContentLength]; hasLength || d.appendSpinnerToBody {
+					return true
+				}
+				injector.start(d.headScripts())
+				return false
 			},
 		}
 
@@ -158,16 +183,25 @@ func (d *AssetServer) ServeHTTP(rw http.ResponseWriter, req *http.Request) {
 		body := recorder.Body()
 		if body == nil {
 			// The body has been streamed and not recorded, we are finished
+			if err := injector.Close(); err != nil {
+				d.logError("Unable to inject the scripts into '%s': %s", path, err)
+			}
 			return
 		}
 
 		code := recorder.Code()
 		switch code {
 		case http.StatusOK:
-			content, err := d.processIndexHTML(body.Bytes())
-			if err != nil {
-				d.serveError(rw, err, "Unable to processIndexHTML")
-				return
+			key := indexHTMLKey(body.Bytes(), d.pluginScriptNames)
+			content, cached := d.indexHTMLCache.get(key)
+			if !cached {
+				var err error
+				content, err = d.processIndexHTML(body.Bytes())
+				if err != nil {
+					d.serveError(rw, err, "Unable to processIndexHTML")
+					return
+				}
+				d.indexHTMLCache.put(key, content)
 			}
 			d.writeBlob(rw, indexHTML, content)
 
@@ -206,7 +240,7 @@ func (d *AssetServer) processIndexHTML(indexHTML []byte) ([]byte, error) {
 	}
 
 	// Inject plugins
-	for scriptName := range d.pluginScripts {
+	for _, scriptName := range d.pluginScriptNames {
 		if err := insertScriptInHead(htmlNode, scriptName); err != nil {
 			return nil, err
 		}
@@ -220,6 +254,18 @@ func (d *AssetServer) processIndexHTML(indexHTML []byte) ([]byte, error) {
 	return buffer.Bytes(), nil
 }
 
+// headScripts renders the script tags that get injected into the head, in the same order as processIndexHTML
+// inserts them
+func (d *AssetServer) headScripts() []byte {
+	var buffer bytes.Buffer
+	for i := len(d.pluginScriptNames) - 1; i >= 0; i-- {
+		html.Render(&buffer, createScriptNode(d.pluginScriptNames[i]))
+	}
+	html.Render(&buffer, createScriptNode(ipcJSPath))
+	html.Render(&buffer, createScriptNode(runtimeJSPath))
+	return buffer.Bytes()
+}
+
 func (d *AssetServer) writeBlob(rw http.ResponseWriter, filename string, blob []byte) {
 	err := serveFile(rw, filename, blob)
 	if err != nil {
@@ -245,7 +291,7 @@ func (d *AssetServer) logError(message string, args ...interface{}) {
 	}
 }
 
-func (AssetServer) isRuntimeInjectionMatch(path string) bool {
+func (*AssetServer) isRuntimeInjectionMatch(path string) bool {
 	if path == "" {
 		path = "/"
 	}
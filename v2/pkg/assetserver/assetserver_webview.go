@@ -2,11 +2,11 @@ package assetserver
 
 import (
 	"fmt"
+	"io"
 	"net/http"
 	"net/url"
 	"strconv"
 	"strings"
-	"sync"
 
 	"github.com/wailsapp/wails/v2/pkg/assetserver/webview"
 )
@@ -15,41 +15,38 @@ type assetServerWebView struct {
 	// ExpectedWebViewHost is checked against the Request Host of every WebViewRequest, other hosts won't be processed.
 	ExpectedWebViewHost string
 
-	dispatchInit    sync.Once
-	dispatchReqC    chan<- webview.Request
-	dispatchWorkers int
+	// scheduler processes the requests by their class, without it every request is processed in its own goroutine
+	scheduler *requestScheduler
+}
+
+// UseRequestScheduler processes the webview requests with worker pools per request class (document, style, script,
+// font, image, media and other), so requests for large images or media can't delay the scripts and styles the page
+// depends on. It must be called before the first request is served.
+func (d *AssetServer) UseRequestScheduler() {
+	d.scheduler = newRequestScheduler(d.processWebViewRequest, requestClassWorkers, requestSharedWorkers)
+}
+
+// RequestStats returns the queue and service time metrics of the webview requests per request class, it's nil if
+// the request scheduler isn't used
+func (d *AssetServer) RequestStats() []RequestClassStats {
+	if d.scheduler == nil {
+		return nil
+	}
+	return d.scheduler.Stats()
 }
 
 // ServeWebViewRequest processes the HTTP Request asynchronously by faking a golang HTTP Server.
 // The request will be finished with a StatusNotImplemented code if no handler has written to the response.
 // The AssetServer takes ownership of the request and the caller mustn't close it or access it in any other way.
 func (d *AssetServer) ServeWebViewRequest(req webview.Request) {
-	d.dispatchInit.Do(func() {
-		workers := d.dispatchWorkers
-		if workers <= 0 {
-			return
-		}
-
-		workerC := make(chan webview.Request, workers*2)
-		for i := 0; i < workers; i++ {
-			go func() {
-				for req := range workerC {
-					d.processWebViewRequest(req)
-				}
-			}()
-		}
-
-		dispatchC := make(chan webview.Request)
-		go queueingDispatcher(50, dispatchC, workerC)
-
-		d.dispatchReqC = dispatchC
-	})
-
-	if d.dispatchReqC == nil {
+	if d.scheduler == nil {
 		go d.processWebViewRequest(req)
-	} else {
-		d.dispatchReqC <- req
+		return
 	}
+
+	uri, _ := req.URL()
+	header, _ := req.Header()
+	d.scheduler.Schedule(req, classifyRequest(uri, header))
 }
 
 func (d *AssetServer) processWebViewRequest(r webview.Request) {
@@ -106,35 +103,15 @@ func (d *AssetServer) processWebViewRequestInternal(r webview.Request) {
 	}
 	defer body.Close()
 
-	req, err := http.NewRequest(method, uri, body)
+	req, err := newWebViewHTTPRequest(method, uri, header, body)
 	if err != nil {
 		d.webviewRequestErrorHandler(uri, rw, fmt.Errorf("HTTP-Request: %w", err))
 		return
 	}
 
-	// For server requests, the URL is parsed from the URI supplied on the Request-Line as stored in RequestURI. For
-	// most requests, fields other than Path and RawQuery will be empty. (See RFC 7230, Section 5.3)
-	req.URL.Scheme = ""
-	req.URL.Host = ""
-	req.URL.Fragment = ""
-	req.URL.RawFragment = ""
-
-	if url := req.URL; req.RequestURI == "" && url != nil {
-		req.RequestURI = url.String()
-	}
-
-	req.Header = header
-
-	if req.RemoteAddr == "" {
-		// 192.0.2.0/24 is "TEST-NET" in RFC 5737
-		req.RemoteAddr = "192.0.2.1:1234"
-	}
-
-	if req.ContentLength == 0 {
-		req.ContentLength = -1
-	} else {
-		size := strconv.FormatInt(req.ContentLength, 10)
-		req.Header.Set(HeaderContentLength, size)
+	req.ContentLength = requestContentLength(body, header)
+	if req.ContentLength > 0 {
+		req.Header.Set(HeaderContentLength, strconv.FormatInt(req.ContentLength, 10))
 	}
 
 	if host := req.Header.Get(HeaderHost); host != "" {
@@ -149,37 +126,89 @@ func (d *AssetServer) processWebViewRequestInternal(r webview.Request) {
 	d.ServeHTTP(rw, req)
 }
 
-func (d *AssetServer) webviewRequestErrorHandler(uri string, rw http.ResponseWriter, err error) {
-	logInfo := uri
-	if uri, err := url.ParseRequestURI(uri); err == nil {
-		logInfo = strings.Replace(logInfo, fmt.Sprintf("%s://%s", uri.Scheme, uri.Host), "", 1)
+// newWebViewHTTPRequest creates the request like the http.Server does for an incoming request. It's created directly
+// instead of with http.NewRequest, which allocates a header that would be replaced and has to format the RequestURI.
+func newWebViewHTTPRequest(method string, uri string, header http.Header, body io.ReadCloser) (*http.Request, error) {
+	if method == "" {
+		method = http.MethodGet
+	}
+	if header == nil {
+		header = http.Header{}
 	}
 
-	d.logError("Error processing request '%s': %s (HttpResponse=500)", logInfo, err)
-	http.Error(rw, err.Error(), http.StatusInternalServerError)
+	u, err := url.Parse(uri)
+	if err != nil {
+		return nil, err
+	}
+	host := u.Host
+
+	// For server requests, the URL is parsed from the URI supplied on the Request-Line as stored in RequestURI. For
+	// most requests, fields other than Path and RawQuery will be empty. (See RFC 7230, Section 5.3)
+	u.Scheme = ""
+	u.Host = ""
+	u.Fragment = ""
+	u.RawFragment = ""
+
+	return &http.Request{
+		Method:     method,
+		URL:        u,
+		Proto:      "HTTP/1.1",
+		ProtoMajor: 1,
+		ProtoMinor: 1,
+		Header:     header,
+		Body:       body,
+		Host:       host,
+		RequestURI: requestURI(uri),
+		// 192.0.2.0/24 is "TEST-NET" in RFC 5737
+		RemoteAddr: "192.0.2.1:1234",
+	}, nil
 }
 
-func queueingDispatcher[T any](minQueueSize uint, inC <-chan T, outC chan<- T) {
-	q := newRingqueue[T](minQueueSize)
-	for {
-		in, ok := <-inC
-		if !ok {
-			return
+// requestURI returns the path and query of the absolute uri, as they would have been sent on the Request-Line
+func requestURI(uri string) string {
+	if i := strings.IndexByte(uri, '#'); i >= 0 {
+		uri = uri[:i]
+	}
+	if i := strings.Index(uri, "://"); i >= 0 {
+		uri = uri[i+len("://"):]
+		if i := strings.IndexAny(uri, "/?"); i >= 0 {
+			uri = uri[i:]
+		} else {
+			uri = ""
 		}
+	}
+	return uri
+}
 
-		q.Add(in)
-		for q.Len() != 0 {
-			out, _ := q.Peek()
-			select {
-			case outC <- out:
-				q.Remove()
-			case in, ok := <-inC:
-				if !ok {
-					return
-				}
-
-				q.Add(in)
-			}
+// contentLengthBody is implemented by request bodies that know their length
+type contentLengthBody interface {
+	ContentLength() int64
+}
+
+// requestContentLength returns the length of the request body, or -1 if it's unknown
+func requestContentLength(body io.ReadCloser, header http.Header) int64 {
+	if body == http.NoBody {
+		return 0
+	}
+
+	if b, ok := body.(contentLengthBody); ok {
+		if length := b.ContentLength(); length >= 0 {
+			return length
 		}
 	}
+
+	if length, err := strconv.ParseInt(header.Get(HeaderContentLength), 10, 64); err == nil && length >= 0 {
+		return length
+	}
+	return -1
+}
+
+func (d *AssetServer) webviewRequestErrorHandler(uri string, rw http.ResponseWriter, err error) {
+	logInfo := uri
+	if uri, err := url.ParseRequestURI(uri); err == nil {
+		logInfo = strings.Replace(logInfo, fmt.Sprintf("%s://%s", uri.Scheme, uri.Host), "", 1)
+	}
+
+	d.logError("Error processing request '%s': %s (HttpResponse=500)", logInfo, err)
+	http.Error(rw, err.Error(), http.StatusInternalServerError)
 }
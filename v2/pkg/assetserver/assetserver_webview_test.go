@@ -0,0 +1,124 @@
+package assetserver
+
+import (
+	"crypto/sha256"
+	"fmt"
+	"io"
+	"net/http"
+	"testing"
+)
+
+// chunkedBody returns size bytes in chunks of at most chunkSize, length is the length it reports or -1
+type chunkedBody struct {
+	remaining int64
+	chunkSize int
+	length    int64
+}
+
+func (b *chunkedBody) Read(p []byte) (int, error) {
+	if b.remaining == 0 {
+		return 0, io.EOF
+	}
+	n := min(len(p), b.chunkSize)
+	if int64(n) > b.remaining {
+		n = int(b.remaining)
+	}
+	b.remaining -= int64(n)
+	return n, nil
+}
+
+func (b *chunkedBody) Close() error { return nil }
+
+func (b *chunkedBody) ContentLength() int64 { return b.length }
+
+func TestRequestContentLength(t *testing.T) {
+	tests := []struct {
+		name   string
+		body   io.ReadCloser
+		header http.Header
+		want   int64
+	}{
+		{"no body", http.NoBody, http.Header{}, 0},
+		{"known length", &chunkedBody{remaining: 10, length: 10}, http.Header{}, 10},
+		{"header", &chunkedBody{remaining: 10, length: -1}, http.Header{HeaderContentLength: {"10"}}, 10},
+		{"unknown", &chunkedBody{remaining: 10, length: -1}, http.Header{}, -1},
+		{"invalid header", io.NopCloser(nil), http.Header{HeaderContentLength: {"-5"}}, -1},
+	}
+
+	for _, tt := range tests {
+		if got := requestContentLength(tt.body, tt.header); got != tt.want {
+			t.Errorf("%s: got %d, want %d", tt.name, got, tt.want)
+		}
+	}
+}
+
+func TestUploadContentLength(t *testing.T) {
+	var contentLength int64
+	var header string
+	var received int64
+	handler := http.HandlerFunc(func(rw http.ResponseWriter, req *http.Request) {
+		contentLength, header = req.ContentLength, req.Header.Get(HeaderContentLength)
+		received, _ = io.Copy(io.Discard, req.Body)
+		rw.WriteHeader(http.StatusNoContent)
+	})
+	server, err := NewAssetServerWithHandler(handler, "", false, nil, testRuntimeAssets{})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	body := &chunkedBody{remaining: 1 << 20, chunkSize: 1000, length: 1 << 20}
+	req := newFakeRequest(http.MethodPost, "wails://wails/upload", http.Header{}, body)
+	server.processWebViewRequestInternal(req)
+
+	if req.rw.code != http.StatusNoContent {
+		t.Fatalf("status %d", req.rw.code)
+	}
+	if contentLength != 1<<20 || header != "1048576" || received != 1<<20 {
+		t.Errorf("ContentLength %d, header %q, received %d bytes", contentLength, header, received)
+	}
+}
+
+// BenchmarkUpload posts a file to a handler that hashes it, the body returns the data in chunks of 64 KiB
+func BenchmarkUpload(b *testing.B) {
+	handler := http.HandlerFunc(func(rw http.ResponseWriter, req *http.Request) {
+		if _, err := io.Copy(sha256.New(), req.Body); err != nil {
+			rw.WriteHeader(http.StatusInternalServerError)
+			return
+		}
+		rw.WriteHeader(http.StatusNoContent)
+	})
+	server, err := NewAssetServerWithHandler(handler, "", false, nil, testRuntimeAssets{})
+	if err != nil {
+		b.Fatal(err)
+	}
+
+	for _, size := range []int64{16 << 20, 256 << 20} {
+		b.Run(fmt.Sprintf("%dMB", size>>20), func(b *testing.B) {
+			b.SetBytes(size)
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				body := &chunkedBody{remaining: size, chunkSize: 64 << 10, length: size}
+				req := newFakeRequest(http.MethodPost, "wails://wails/upload", http.Header{}, body)
+				server.processWebViewRequestInternal(req)
+				if req.rw.code != http.StatusNoContent {
+					b.Fatalf("status %d", req.rw.code)
+				}
+			}
+		})
+	}
+}
+
+func TestRequestURI(t *testing.T) {
+	tests := map[string]string{
+		"wails://wails":                     "",
+		"wails://wails/":                    "/",
+		"wails://wails/assets/app.js?v=1#x": "/assets/app.js?v=1",
+		"wails://wails?query":               "?query",
+		"http://localhost:34115/index.html": "/index.html",
+	}
+	for uri, want := range tests {
+		if got := requestURI(uri); got != want {
+			t.Errorf("%s: got %q, want %q", uri, got, want)
+		}
+	}
+}
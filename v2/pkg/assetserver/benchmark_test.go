@@ -0,0 +1,236 @@
+package assetserver
+
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"math/rand"
+	"net/http"
+	"sort"
+	"testing"
+	"testing/fstest"
+	"time"
+
+	"github.com/wailsapp/wails/v2/pkg/assetserver/webview"
+	"github.com/wailsapp/wails/v2/pkg/options/assetserver"
+)
+
+// The benchmarks drive the AssetServer with in-process webview requests, like the webviews of the platforms do. Besides
+// ns/op and the allocations they report the requests per second and the p50 and p99 latency of the requests:
+//
+//	go test -run '^$' -bench AssetServer -benchmem ./pkg/assetserver
+
+const (
+	benchmarkModules    = 300
+	benchmarkImages     = 4
+	benchmarkImageSize  = 2 << 20
+	benchmarkModuleSize = 2 << 10
+)
+
+// fakeRequest is an in-process webview.Request, done is closed once the AssetServer has closed the request
+type fakeRequest struct {
+	method string
+	uri    string
+	header http.Header
+	body   io.ReadCloser
+	rw     fakeResponseWriter
+
+	done   chan struct{}
+	closed time.Time
+}
+
+func newFakeRequest(method string, uri string, header http.Header, body io.ReadCloser) *fakeRequest {
+	return &fakeRequest{
+		method: method,
+		uri:    uri,
+		header: header,
+		body:   body,
+		rw:     fakeResponseWriter{discardResponseWriter: discardResponseWriter{header: http.Header{}}},
+		done:   make(chan struct{}),
+	}
+}
+
+func (r *fakeRequest) URL() (string, error)             { return r.uri, nil }
+func (r *fakeRequest) Method() (string, error)          { return r.method, nil }
+func (r *fakeRequest) Header() (http.Header, error)     { return r.header, nil }
+func (r *fakeRequest) Body() (io.ReadCloser, error)     { return r.body, nil }
+func (r *fakeRequest) Response() webview.ResponseWriter { return &r.rw }
+
+func (r *fakeRequest) Close() error {
+	r.closed = time.Now()
+	close(r.done)
+	return nil
+}
+
+// fakeResponseWriter is a webview.ResponseWriter that discards the body
+type fakeResponseWriter struct {
+	discardResponseWriter
+}
+
+func (rw *fakeResponseWriter) Finish() error { return nil }
+
+// webkitRequestHeader returns the headers WebKit sends for a subresource of the given destination
+func webkitRequestHeader(dest string) http.Header {
+	return http.Header{
+		"Accept":          {"*/*"},
+		"Accept-Encoding": {"gzip, deflate"},
+		"Accept-Language": {"en-US"},
+		"Referer":         {"wails://wails/"},
+		"Sec-Fetch-Dest":  {dest},
+		"User-Agent":      {"Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/605.1.15 (KHTML, like Gecko)"},
+	}
+}
+
+// newBenchmarkAssetServer returns an AssetServer for an app with an index.html that loads hundreds of small ES
+// modules, a few large images and a handler for an API
+func newBenchmarkAssetServer(b *testing.B) *AssetServer {
+	random := rand.New(rand.NewSource(1))
+
+	var index bytes.Buffer
+	index.WriteString(`<!DOCTYPE html><html lang="en"><head><meta charset="UTF-8"><title>app</title>`)
+	index.WriteString(`<script type="module" src="/assets/module-000.js"></script></head><body><div id="app"></div>`)
+	assets := fstest.MapFS{}
+	for i := 0; i < benchmarkModules; i++ {
+		module := fmt.Sprintf("import './module-%03d.js';\nexport const value%d = %d;\n", (i+1)%benchmarkModules, i, i)
+		assets[moduleName(i)] = &fstest.MapFile{Data: bytes.Repeat([]byte(module), benchmarkModuleSize/len(module))}
+	}
+	for i := 0; i < benchmarkImages; i++ {
+		image := make([]byte, benchmarkImageSize)
+		random.Read(image)
+		copy(image, "\xff\xd8\xff\xe0\x00\x10JFIF\x00")
+		assets[imageName(i)] = &fstest.MapFile{Data: image}
+		fmt.Fprintf(&index, `<img src="/%s">`, imageName(i))
+	}
+	index.WriteString(`</body></html>`)
+	assets["index.html"] = &fstest.MapFile{Data: index.Bytes()}
+
+	api := http.HandlerFunc(func(rw http.ResponseWriter, req *http.Request) {
+		rw.Header().Set(HeaderContentType, "application/json")
+		rw.Write([]byte(`{"items":[1,2,3]}`))
+	})
+
+	server, err := NewAssetServer("", assetserver.Options{Assets: assets, Handler: api}, false, nil, testRuntimeAssets{})
+	if err != nil {
+		b.Fatal(err)
+	}
+	return server
+}
+
+func moduleName(i int) string { return fmt.Sprintf("assets/module-%03d.js", i) }
+
+func imageName(i int) string { return fmt.Sprintf("images/photo-%d.jpg", i) }
+
+type benchmarkRequest struct {
+	uri  string
+	dest string
+}
+
+// BenchmarkAssetServer serves the requests of a workload one after another with processWebViewRequestInternal
+func BenchmarkAssetServer(b *testing.B) {
+	server := newBenchmarkAssetServer(b)
+
+	var modules []benchmarkRequest
+	for i := 0; i < benchmarkModules; i++ {
+		modules = append(modules, benchmarkRequest{"wails://wails/" + moduleName(i), "script"})
+	}
+	var images []benchmarkRequest
+	for i := 0; i < benchmarkImages; i++ {
+		images = append(images, benchmarkRequest{"wails://wails/" + imageName(i), "image"})
+	}
+
+	workloads := []struct {
+		name     string
+		requests []benchmarkRequest
+	}{
+		{"modules", modules},
+		{"images", images},
+		{"index", []benchmarkRequest{{"wails://wails/", "document"}}},
+		{"runtime", []benchmarkRequest{{"wails://wails" + runtimeJSPath, "script"}}},
+		{"fallback", []benchmarkRequest{{"wails://wails/api/items", "empty"}}},
+	}
+
+	for _, workload := range workloads {
+		requests := workload.requests
+		b.Run(workload.name, func(b *testing.B) {
+			latencies := make([]time.Duration, 0, b.N)
+			b.ReportAllocs()
+			b.ResetTimer()
+
+			start := time.Now()
+			for i := 0; i < b.N; i++ {
+				r := requests[i%len(requests)]
+				req := newFakeRequest(http.MethodGet, r.uri, webkitRequestHeader(r.dest), nil)
+
+				started := time.Now()
+				server.processWebViewRequestInternal(req)
+				latencies = append(latencies, time.Since(started))
+
+				if req.rw.code != http.StatusOK || req.rw.written == 0 {
+					b.Fatalf("%s: status %d with %d bytes", r.uri, req.rw.code, req.rw.written)
+				}
+			}
+			reportLatencies(b, latencies, time.Since(start))
+		})
+	}
+}
+
+// BenchmarkAssetServerPageLoad loads the page with all its modules and images at once through ServeWebViewRequest,
+// one op is a page load. The latency of a request is the time from ServeWebViewRequest until it has been closed.
+func BenchmarkAssetServerPageLoad(b *testing.B) {
+	requests := []benchmarkRequest{{"wails://wails/", "document"}}
+	for i := 0; i < benchmarkModules; i++ {
+		requests = append(requests, benchmarkRequest{"wails://wails/" + moduleName(i), "script"})
+	}
+	for i := 0; i < benchmarkImages; i++ {
+		requests = append(requests, benchmarkRequest{"wails://wails/" + imageName(i), "image"})
+	}
+
+	for _, scheduled := range []bool{false, true} {
+		name := "goroutines"
+		if scheduled {
+			name = "scheduler"
+		}
+
+		b.Run(name, func(b *testing.B) {
+			server := newBenchmarkAssetServer(b)
+			if scheduled {
+				server.UseRequestScheduler()
+			}
+
+			latencies := make([]time.Duration, 0, b.N*len(requests))
+			reqs := make([]*fakeRequest, len(requests))
+			queued := make([]time.Time, len(requests))
+			b.ReportAllocs()
+			b.ResetTimer()
+
+			start := time.Now()
+			for i := 0; i < b.N; i++ {
+				for j, r := range requests {
+					reqs[j] = newFakeRequest(http.MethodGet, r.uri, webkitRequestHeader(r.dest), nil)
+					queued[j] = time.Now()
+					server.ServeWebViewRequest(reqs[j])
+				}
+				for j, req := range reqs {
+					<-req.done
+					latencies = append(latencies, req.closed.Sub(queued[j]))
+					if req.rw.code != http.StatusOK {
+						b.Fatalf("%s: status %d", req.uri, req.rw.code)
+					}
+				}
+			}
+			reportLatencies(b, latencies, time.Since(start))
+		})
+	}
+}
+
+// reportLatencies reports the requests per second and the p50 and p99 latency of the requests
+func reportLatencies(b *testing.B, latencies []time.Duration, elapsed time.Duration) {
+	if len(latencies) == 0 {
+		return
+	}
+	sort.Slice(latencies, func(i, j int) bool { return latencies[i] < latencies[j] })
+
+	b.ReportMetric(float64(len(latencies))/elapsed.Seconds(), "req/s")
+	b.ReportMetric(float64(latencies[len(latencies)/2].Nanoseconds()), "p50-ns")
+	b.ReportMetric(float64(latencies[len(latencies)*99/100].Nanoseconds()), "p99-ns")
+}
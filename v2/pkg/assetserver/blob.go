@@ -0,0 +1,180 @@
+package assetserver
+
+import (
+	"crypto/rand"
+	"encoding/hex"
+	"fmt"
+	"net/http"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+)
+
+const blobPathPrefix = "/wails/blob/"
+
+const (
+	// blobTTL is the time the frontend has to fetch a blob before it gets discarded
+	blobTTL = 30 * time.Second
+
+	// maxBlobStoreSize is the maximum size of all blobs that haven't been fetched yet
+	maxBlobStoreSize = 1 << 30
+)
+
+// Blob is binary data returned by a bound method. Instead of being marshalled into the JSON result of the call, the
+// data is kept in memory and the frontend fetches it as an ArrayBuffer from the AssetServer:
+//
+//	func (a *App) Thumbnail(name string) (*assetserver.Blob, error) {
+//		data, err := os.ReadFile(name)
+//		if err != nil {
+//			return nil, err
+//		}
+//		return assetserver.NewBlob(data, "image/png"), nil
+//	}
+//
+// The data must not be modified after the Blob has been returned.
+type Blob struct {
+	Data        []byte
+	ContentType string
+}
+
+// NewBlob returns a Blob for the data, the contentType defaults to application/octet-stream
+func NewBlob(data []byte, contentType string) *Blob {
+	return &Blob{Data: data, ContentType: contentType}
+}
+
+// BlobHandle is the JSON result of a call that returned a Blob, the runtime resolves it with the fetched data
+type BlobHandle struct {
+	URL  string `json:"wailsblob"`
+	Size int    `json:"size"`
+}
+
+// RegisterBlob stores the blob until it has been fetched by the frontend, at most for 30 seconds. The handle can only
+// be fetched once.
+func RegisterBlob(blob *Blob) (*BlobHandle, error) {
+	return blobs.register(blob, time.Now())
+}
+
+var blobs = &blobStore{
+	entries: make(map[string]*blobEntry),
+	ttl:     blobTTL,
+	maxSize: maxBlobStoreSize,
+}
+
+type blobEntry struct {
+	id      string
+	blob    *Blob
+	expires time.Time
+}
+
+// blobStore keeps the registered blobs in the order they have been registered, expired blobs and the oldest blobs
+// are discarded if the store would exceed its maximum size
+type blobStore struct {
+	mu      sync.Mutex
+	entries map[string]*blobEntry
+	order   []*blobEntry
+	size    int
+	ttl     time.Duration
+	maxSize int
+}
+
+func (s *blobStore) register(blob *Blob, now time.Time) (*BlobHandle, error) {
+	if blob == nil {
+		return nil, fmt.Errorf("blob is nil")
+	}
+	if len(blob.Data) > s.maxSize {
+		return nil, fmt.Errorf("blob of %d bytes exceeds the maximum size of %d bytes", len(blob.Data), s.maxSize)
+	}
+
+	var id [16]byte
+	if _, err := rand.Read(id[:]); err != nil {
+		return nil, err
+	}
+	entry := &blobEntry{
+		id:      hex.EncodeToString(id[:]),
+		blob:    blob,
+		expires: now.Add(s.ttl),
+	}
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	s.expireLocked(now)
+	for s.size+len(blob.Data) > s.maxSize {
+		s.removeLocked(s.order[0])
+	}
+
+	s.entries[entry.id] = entry
+	s.order = append(s.order, entry)
+	s.size += len(blob.Data)
+	return &BlobHandle{URL: blobPathPrefix + entry.id, Size: len(blob.Data)}, nil
+}
+
+// take removes the blob from the store and returns it
+func (s *blobStore) take(id string, now time.Time) (*Blob, bool) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	s.expireLocked(now)
+	entry, ok := s.entries[id]
+	if !ok {
+		return nil, false
+	}
+	s.removeLocked(entry)
+	return entry.blob, true
+}
+
+// expireLocked removes the expired blobs, all blobs have the same ttl so they expire in order
+func (s *blobStore) expireLocked(now time.Time) {
+	for len(s.order) > 0 && !now.Before(s.order[0].expires) {
+		s.removeLocked(s.order[0])
+	}
+}
+
+func (s *blobStore) removeLocked(entry *blobEntry) {
+	for i, e := range s.order {
+		if e == entry {
+			copy(s.order[i:], s.order[i+1:])
+			s.order[len(s.order)-1] = nil
+			s.order = s.order[:len(s.order)-1]
+			break
+		}
+	}
+	delete(s.entries, entry.id)
+	s.size -= len(entry.blob.Data)
+}
+
+// bodyFinisher is implemented by ResponseWriters that can send a body without copying it
+type bodyFinisher interface {
+	FinishWithBody(body []byte) error
+}
+
+// serveBlob replies with the blob of the path and removes it from the store
+func (d *AssetServer) serveBlob(rw http.ResponseWriter, path string) {
+	blob, ok := blobs.take(strings.TrimPrefix(path, blobPathPrefix), time.Now())
+	if !ok {
+		rw.WriteHeader(http.StatusNotFound)
+		return
+	}
+
+	contentType := blob.ContentType
+	if contentType == "" {
+		contentType = "application/octet-stream"
+	}
+	header := rw.Header()
+	header.Set(HeaderContentType, contentType)
+	header.Set(HeaderContentLength, strconv.Itoa(len(blob.Data)))
+	header.Set(HeaderCacheControl, "no-store")
+
+	if finisher, ok := rw.(bodyFinisher); ok {
+		if err := finisher.FinishWithBody(blob.Data); err != nil {
+			d.logError("Unable to write blob '%s': %s", path, err)
+		}
+		return
+	}
+
+	rw.WriteHeader(http.StatusOK)
+	if _, err := rw.Write(blob.Data); err != nil {
+		d.logError("Unable to write blob '%s': %s", path, err)
+	}
+}
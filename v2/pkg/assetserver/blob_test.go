@@ -0,0 +1,157 @@
+package assetserver
+
+import (
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+	"time"
+)
+
+func TestBlobStore(t *testing.T) {
+	s := &blobStore{entries: make(map[string]*blobEntry), ttl: time.Minute, maxSize: 100}
+	now := time.Now()
+
+	register := func(size int, at time.Time) string {
+		handle, err := s.register(NewBlob(make([]byte, size), ""), at)
+		if err != nil {
+			t.Fatal(err)
+		}
+		return handle.URL[len(blobPathPrefix):]
+	}
+
+	// A blob can be taken once
+	first := register(10, now)
+	if _, ok := s.take(first, now); !ok {
+		t.Fatal("blob not found")
+	}
+	if _, ok := s.take(first, now); ok {
+		t.Error("blob has been taken twice")
+	}
+
+	// Expired blobs are removed
+	expired := register(10, now)
+	if _, ok := s.take(expired, now.Add(time.Minute)); ok {
+		t.Error("expired blob has been taken")
+	}
+
+	// The oldest blobs are evicted to stay within the maximum size
+	oldest := register(60, now)
+	newer := register(30, now.Add(time.Second))
+	newest := register(50, now.Add(2*time.Second))
+	if _, ok := s.take(oldest, now); ok {
+		t.Error("oldest blob has not been evicted")
+	}
+	if s.size != 80 {
+		t.Errorf("size %d, want 80", s.size)
+	}
+	for _, id := range []string{newer, newest} {
+		if _, ok := s.take(id, now); !ok {
+			t.Errorf("blob %s has been evicted", id)
+		}
+	}
+
+	if _, err := s.register(NewBlob(make([]byte, 101), ""), now); err == nil {
+		t.Error("blob larger than the store has been registered")
+	}
+}
+
+func TestServeBlob(t *testing.T) {
+	server, err := NewAssetServerWithHandler(http.NotFoundHandler(), "", false, nil, testRuntimeAssets{})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	data := []byte{0, 1, 2, 3, 0xff}
+	handle, err := RegisterBlob(NewBlob(data, "image/png"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	result, _ := json.Marshal(handle)
+	if want := fmt.Sprintf(`{"wailsblob":"%s","size":5}`, handle.URL); string(result) != want {
+		t.Errorf("handle %s, want %s", result, want)
+	}
+
+	rec := httptest.NewRecorder()
+	server.ServeHTTP(rec, httptest.NewRequest(http.MethodGet, handle.URL, nil))
+	if rec.Code != http.StatusOK || !bytes.Equal(rec.Body.Bytes(), data) {
+		t.Fatalf("status %d with %v", rec.Code, rec.Body.Bytes())
+	}
+	if got := rec.Header().Get(HeaderContentType); got != "image/png" {
+		t.Errorf("Content-Type %q", got)
+	}
+	if got := rec.Header().Get(HeaderCacheControl); got != "no-store" {
+		t.Errorf("Cache-Control %q", got)
+	}
+
+	rec = httptest.NewRecorder()
+	server.ServeHTTP(rec, httptest.NewRequest(http.MethodGet, handle.URL, nil))
+	if rec.Code != http.StatusNotFound {
+		t.Errorf("second fetch has status %d", rec.Code)
+	}
+}
+
+// BenchmarkBlob compares returning binary data as the JSON result of a call, which marshals it as base64 and has to
+// be decoded by the frontend, with returning a blob handle that is fetched from the AssetServer
+func BenchmarkBlob(b *testing.B) {
+	server, err := NewAssetServerWithHandler(http.NotFoundHandler(), "", false, nil, testRuntimeAssets{})
+	if err != nil {
+		b.Fatal(err)
+	}
+
+	for _, size := range []int{1 << 20, 10 << 20, 100 << 20} {
+		data := make([]byte, size)
+		for i := range data {
+			data[i] = byte(i)
+		}
+
+		b.Run(fmt.Sprintf("json/%dMB", size>>20), func(b *testing.B) {
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				message, err := json.Marshal(struct {
+					Result []byte `json:"result"`
+				}{data})
+				if err != nil {
+					b.Fatal(err)
+				}
+
+				var decoded struct {
+					Result []byte `json:"result"`
+				}
+				if err := json.Unmarshal(message, &decoded); err != nil || len(decoded.Result) != size {
+					b.Fatalf("unable to decode the result: %v", err)
+				}
+			}
+		})
+
+		b.Run(fmt.Sprintf("blob/%dMB", size>>20), func(b *testing.B) {
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				handle, err := RegisterBlob(NewBlob(data, ""))
+				if err != nil {
+					b.Fatal(err)
+				}
+				message, err := json.Marshal(struct {
+					Result *BlobHandle `json:"result"`
+				}{handle})
+				if err != nil {
+					b.Fatal(err)
+				}
+
+				var decoded struct {
+					Result BlobHandle `json:"result"`
+				}
+				if err := json.Unmarshal(message, &decoded); err != nil {
+					b.Fatal(err)
+				}
+				rw := &discardResponseWriter{header: http.Header{}}
+				server.ServeHTTP(rw, httptest.NewRequest(http.MethodGet, decoded.Result.URL, nil))
+				if rw.code != http.StatusOK || rw.written != int64(size) {
+					b.Fatalf("status %d with %d bytes", rw.code, rw.written)
+				}
+			}
+		})
+	}
+}
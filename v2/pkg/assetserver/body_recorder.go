@@ -26,6 +26,16 @@ func (rw *bodyRecorder) WriteHeader(code int) {
 	rw.writeHeader(nil, code)
 }
 
+// Flush flushes the response if it's not recorded
+func (rw *bodyRecorder) Flush() {
+	if !rw.wroteHeader || rw.body != nil {
+		return
+	}
+	if flusher, ok := rw.ResponseWriter.(http.Flusher); ok {
+		flusher.Flush()
+	}
+}
+
 func (rw *bodyRecorder) Code() int {
 	return rw.code
 }
@@ -37,8 +37,14 @@ const (
 	HeaderContentLength = "Content-Length"
 	HeaderUserAgent     = "User-Agent"
 	HeaderCacheControl  = "Cache-Control"
+	HeaderETag          = "Etag"
+	HeaderIfNoneMatch   = "If-None-Match"
 	HeaderUpgrade       = "Upgrade"
 
+	HeaderAcceptEncoding  = "Accept-Encoding"
+	HeaderContentEncoding = "Content-Encoding"
+	HeaderVary            = "Vary"
+
 	WailsUserAgentValue = "wails.io"
 )
 
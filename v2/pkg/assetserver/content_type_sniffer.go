@@ -1,6 +1,7 @@
 package assetserver
 
 import (
+	"io"
 	"net/http"
 )
 
@@ -40,3 +41,44 @@ func (rw *contentTypeSniffer) writeHeader(b []byte) {
 
 	rw.WriteHeader(http.StatusOK)
 }
+
+// ReadFrom lets the ResponseWriter read the content itself if it supports it and the Content-Type is known
+func (rw *contentTypeSniffer) ReadFrom(r io.Reader) (int64, error) {
+	readerFrom, ok := rw.rw.(io.ReaderFrom)
+	if !ok || (!rw.wroteHeader && rw.rw.Header().Get(HeaderContentType) == "") {
+		return io.Copy(writerOnly{rw}, r)
+	}
+
+	rw.WriteHeader(http.StatusOK)
+	return readerFrom.ReadFrom(r)
+}
+
+// FinishWithBody lets the ResponseWriter send the body without copying it if it supports it
+func (rw *contentTypeSniffer) FinishWithBody(body []byte) error {
+	finisher, ok := rw.rw.(bodyFinisher)
+	if !ok {
+		_, err := rw.Write(body)
+		return err
+	}
+
+	if !rw.wroteHeader {
+		m := rw.rw.Header()
+		if _, hasType := m[HeaderContentType]; !hasType {
+			m.Set(HeaderContentType, http.DetectContentType(body))
+		}
+		rw.wroteHeader = true
+	}
+	return finisher.FinishWithBody(body)
+}
+
+func (rw *contentTypeSniffer) Flush() {
+	if flusher, ok := rw.rw.(http.Flusher); ok {
+		rw.WriteHeader(http.StatusOK)
+		flusher.Flush()
+	}
+}
+
+// writerOnly hides the ReadFrom method of a ResponseWriter from io.Copy
+type writerOnly struct {
+	io.Writer
+}
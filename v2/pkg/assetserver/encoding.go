@@ -0,0 +1,63 @@
+package assetserver
+
+import (
+	"strconv"
+	"strings"
+)
+
+// preferredVariant returns the precompressed variant the client accepts with the highest quality, nil if it accepts
+// none of them. On equal quality the order of the variants decides, which prefers `br` over `gzip`.
+func preferredVariant(acceptEncoding string, variants []ManifestVariant) *ManifestVariant {
+	if acceptEncoding == "" || len(variants) == 0 {
+		return nil
+	}
+
+	var best *ManifestVariant
+	var bestQuality float64
+	for i := range variants {
+		quality := acceptedQuality(acceptEncoding, variants[i].Encoding)
+		if quality > bestQuality {
+			best, bestQuality = &variants[i], quality
+		}
+	}
+	return best
+}
+
+// acceptedQuality returns the quality of the encoding in the Accept-Encoding header, an explicit entry for the
+// encoding takes precedence over `*`
+func acceptedQuality(acceptEncoding string, encoding string) float64 {
+	wildcard := 0.0
+	for remaining := acceptEncoding; remaining != ""; {
+		var coding string
+		coding, remaining, _ = strings.Cut(remaining, ",")
+
+		coding, params, _ := strings.Cut(coding, ";")
+		coding = strings.TrimSpace(coding)
+
+		quality := 1.0
+		if name, value, ok := strings.Cut(strings.TrimSpace(params), "="); ok && strings.TrimSpace(name) == "q" {
+			q, err := strconv.ParseFloat(strings.TrimSpace(value), 64)
+			if err != nil {
+				continue
+			}
+			quality = q
+		}
+
+		switch {
+		case strings.EqualFold(coding, encoding):
+			return quality
+		case coding == "*":
+			wildcard = quality
+		}
+	}
+	return wildcard
+}
+
+// variantETag derives the ETag of a precompressed variant from the ETag of its asset, the representations differ so
+// their ETags need to differ as well
+func variantETag(etag string, encoding string) string {
+	if len(etag) < 2 {
+		return etag
+	}
+	return etag[:len(etag)-1] + "-" + encoding + `"`
+}
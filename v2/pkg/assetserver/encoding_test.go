@@ -0,0 +1,189 @@
+package assetserver
+
+import (
+	"bytes"
+	"compress/gzip"
+	"fmt"
+	"io"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+	"testing/fstest"
+
+	"github.com/wailsapp/wails/v2/pkg/options/assetserver"
+)
+
+func TestPreferredVariant(t *testing.T) {
+	variants := []ManifestVariant{{Encoding: "br"}, {Encoding: "gzip"}}
+
+	tests := []struct {
+		acceptEncoding string
+		want           string
+	}{
+		{"", ""},
+		{"identity", ""},
+		{"gzip", "gzip"},
+		{"gzip, deflate, br", "br"},
+		{"br;q=0.5, gzip", "gzip"},
+		{"br;q=0, gzip;q=0", ""},
+		{"*", "br"},
+		{"*;q=0.5, gzip", "gzip"},
+		{"GZIP;q=0.8", "gzip"},
+		{"br;q=invalid, gzip;q=0.1", "gzip"},
+	}
+
+	for _, tt := range tests {
+		got := ""
+		if variant := preferredVariant(tt.acceptEncoding, variants); variant != nil {
+			got = variant.Encoding
+		}
+		if got != tt.want {
+			t.Errorf("Accept-Encoding %q: got %q, want %q", tt.acceptEncoding, got, tt.want)
+		}
+	}
+}
+
+func TestServePrecompressedVariant(t *testing.T) {
+	handler := newVariantsHandler(t, 1)
+
+	for _, acceptEncoding := range []string{"", "gzip"} {
+		req := httptest.NewRequest(http.MethodGet, "/assets/module-0.js", nil)
+		if acceptEncoding != "" {
+			req.Header.Set(HeaderAcceptEncoding, acceptEncoding)
+		}
+		rec := httptest.NewRecorder()
+		handler.ServeHTTP(rec, req)
+
+		res := rec.Result()
+		if res.StatusCode != http.StatusOK {
+			t.Fatalf("status %d", res.StatusCode)
+		}
+		if got := res.Header.Get(HeaderContentEncoding); got != acceptEncoding {
+			t.Errorf("Content-Encoding %q, want %q", got, acceptEncoding)
+		}
+		if res.ContentLength < 0 {
+			t.Errorf("no Content-Length for Accept-Encoding %q", acceptEncoding)
+		}
+		if got := res.Header.Get(HeaderVary); got != HeaderAcceptEncoding {
+			t.Errorf("Vary %q", got)
+		}
+		if got := res.Header.Get(HeaderContentType); got != "text/javascript; charset=utf-8" {
+			t.Errorf("Content-Type %q", got)
+		}
+
+		body := readBody(t, res)
+		if !bytes.Equal(body, moduleSource(0)) {
+			t.Errorf("unexpected body for Accept-Encoding %q", acceptEncoding)
+		}
+	}
+}
+
+// BenchmarkColdLoad measures loading the start page and its modules with an empty cache from the AssetServer over
+// HTTP, like a browser does in the devserver browser mode. The browser decompresses the modules.
+func BenchmarkColdLoad(b *testing.B) {
+	const modules = 20
+
+	for _, bench := range []struct {
+		name           string
+		acceptEncoding string
+	}{
+		{"identity", ""},
+		{"precompressed", "gzip"},
+	} {
+		b.Run(bench.name, func(b *testing.B) {
+			server := httptest.NewServer(newVariantsHandler(b, modules))
+			defer server.Close()
+
+			client := &http.Client{Transport: &http.Transport{DisableCompression: true}}
+			var transferred int64
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				transferred = 0
+				for m := -1; m < modules; m++ {
+					url := server.URL + "/"
+					if m >= 0 {
+						url = server.URL + fmt.Sprintf("/assets/module-%d.js", m)
+					}
+					req, _ := http.NewRequest(http.MethodGet, url, nil)
+					if bench.acceptEncoding != "" {
+						req.Header.Set(HeaderAcceptEncoding, bench.acceptEncoding)
+					}
+					res, err := client.Do(req)
+					if err != nil {
+						b.Fatal(err)
+					}
+					transferred += res.ContentLength
+					readBody(b, res)
+				}
+			}
+			b.ReportMetric(float64(transferred), "bytes/load")
+		})
+	}
+}
+
+// newVariantsHandler returns an AssetHandler for an embedded FS with a manifest, every module has a gzip variant
+func newVariantsHandler(tb testing.TB, modules int) http.Handler {
+	fsys := fstest.MapFS{
+		"dist/index.html": {Data: []byte(`<html><head><script type="module" src="/assets/module-0.js"></script></head></html>`)},
+	}
+	variants := map[string]bool{}
+	for m := 0; m < modules; m++ {
+		source := moduleSource(m)
+
+		var compressed bytes.Buffer
+		w, _ := gzip.NewWriterLevel(&compressed, gzip.BestCompression)
+		w.Write(source)
+		w.Close()
+
+		fsys[fmt.Sprintf("dist/assets/module-%d.js", m)] = &fstest.MapFile{Data: source}
+		fsys[fmt.Sprintf("dist/assets/module-%d.js.gz", m)] = &fstest.MapFile{Data: compressed.Bytes()}
+		variants[fmt.Sprintf("dist/assets/module-%d.js.gz", m)] = true
+	}
+
+	manifest, err := BuildManifest(fsys, false, variants)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	data, err := manifest.MarshalBinary()
+	if err != nil {
+		tb.Fatal(err)
+	}
+	fsys[ManifestFileName] = &fstest.MapFile{Data: data}
+
+	handler, err := NewAssetHandler(assetserver.Options{Assets: fsys}, nil)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	if handler.(*assetHandler).manifest == nil {
+		tb.Fatal("the manifest has not been loaded")
+	}
+	return handler
+}
+
+// moduleSource returns about 256 KiB of bundled JavaScript
+func moduleSource(m int) []byte {
+	var buf bytes.Buffer
+	for i := 0; buf.Len() < 256<<10; i++ {
+		fmt.Fprintf(&buf, "export function component%d_%d(props) {\n\tconst state = useState(props.value%d);\n\treturn h(\"div\", { class: \"item-%d\", onClick: () => state.set(%d) }, props.children);\n}\n", m, i, i%7, i, i*31%997)
+	}
+	return buf.Bytes()
+}
+
+func readBody(tb testing.TB, res *http.Response) []byte {
+	defer res.Body.Close()
+
+	var body io.Reader = res.Body
+	if res.Header.Get(HeaderContentEncoding) == "gzip" {
+		r, err := gzip.NewReader(res.Body)
+		if err != nil {
+			tb.Fatal(err)
+		}
+		body = r
+	}
+
+	data, err := io.ReadAll(body)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return data
+}
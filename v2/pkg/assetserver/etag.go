@@ -0,0 +1,104 @@
+package assetserver
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"io"
+	"net/http"
+	"path"
+	"strings"
+)
+
+const (
+	// cacheControlImmutable is used for fingerprinted assets, a new build changes their name
+	cacheControlImmutable = "public, max-age=31536000, immutable"
+
+	// cacheControlRevalidate lets WebKit cache assets, but revalidate them with their ETag
+	cacheControlRevalidate = "no-cache"
+)
+
+// contentETag returns the strong ETag for the content hash of an asset
+func contentETag(hash [sha256.Size]byte) string {
+	return `"` + hex.EncodeToString(hash[:16]) + `"`
+}
+
+// readerETag hashes the content of the reader and rewinds it
+func readerETag(file io.ReadSeeker) (string, error) {
+	hash := sha256.New()
+	if _, err := io.Copy(hash, file); err != nil {
+		return "", err
+	}
+	if _, err := file.Seek(0, io.SeekStart); err != nil {
+		return "", err
+	}
+
+	var sum [sha256.Size]byte
+	hash.Sum(sum[:0])
+	return contentETag(sum), nil
+}
+
+// setAssetCacheHeaders sets the ETag and Cache-Control of an embedded asset, unless they have already been set.
+// `index.html` gets the runtime injected, the injected scripts change with every start of the app, so it's never
+// cached.
+func setAssetCacheHeaders(header http.Header, filename string, etag string) {
+	if path.Base(filename) == indexHTML {
+		return
+	}
+
+	if _, ok := header[HeaderETag]; !ok && etag != "" {
+		header[HeaderETag] = []string{etag}
+	}
+
+	if _, ok := header[HeaderCacheControl]; !ok {
+		if isFingerprinted(filename) {
+			header[HeaderCacheControl] = []string{cacheControlImmutable}
+		} else {
+			header[HeaderCacheControl] = []string{cacheControlRevalidate}
+		}
+	}
+}
+
+// isFingerprinted returns true if the filename contains a content hash, like `index-4f3a9c1b.js` or
+// `app.BkX7q9aZ.css` as generated by bundlers. The hash needs at least 8 characters with letters and digits.
+func isFingerprinted(filename string) bool {
+	name := path.Base(filename)
+	ext := path.Ext(name)
+	if ext == "" {
+		return false
+	}
+	stem := strings.TrimSuffix(name, ext)
+
+	separator := strings.LastIndexAny(stem, ".-")
+	if separator < 1 {
+		return false
+	}
+	fingerprint := stem[separator+1:]
+	if len(fingerprint) < 8 {
+		return false
+	}
+
+	var hasDigit, hasLetter bool
+	for _, c := range fingerprint {
+		switch {
+		case c >= '0' && c <= '9':
+			hasDigit = true
+		case c >= 'a' && c <= 'z', c >= 'A' && c <= 'Z':
+			hasLetter = true
+		case c == '_':
+		default:
+			return false
+		}
+	}
+	return hasDigit && hasLetter
+}
+
+// etagMatches implements the weak comparison of If-None-Match
+func etagMatches(ifNoneMatch string, etag string) bool {
+	for _, candidate := range strings.Split(ifNoneMatch, ",") {
+		candidate = strings.TrimSpace(candidate)
+		if candidate == "*" || strings.TrimPrefix(candidate, "W/") == strings.TrimPrefix(etag, "W/") {
+			return true
+		}
+	}
+	return false
+}
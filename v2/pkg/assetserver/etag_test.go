@@ -0,0 +1,92 @@
+package assetserver
+
+import (
+	"crypto/sha256"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+	"testing/fstest"
+
+	"github.com/wailsapp/wails/v2/pkg/options/assetserver"
+)
+
+func TestIsFingerprinted(t *testing.T) {
+	tests := map[string]bool{
+		"assets/index-4f3a9c1b.js":   true,
+		"assets/app.BkX7q9aZ.css":    true,
+		"assets/vendor-3f2a9c1b.mjs": true,
+		"main.7d3c2e1f0a9b8c7d.js":   true,
+		"index.html":                 false,
+		"main.js":                    false,
+		"assets/my-component.js":     false,
+		"assets/utils-abcdefgh.js":   false,
+		"assets/chunk-12345678.js":   false,
+		"assets/logo-4f3a.svg":       false,
+		"assets/4f3a9c1b4f3a":        false,
+		"-4f3a9c1b.js":               false,
+	}
+	for filename, want := range tests {
+		if got := isFingerprinted(filename); got != want {
+			t.Errorf("isFingerprinted(%q) = %t, want %t", filename, got, want)
+		}
+	}
+}
+
+func TestEtagMatches(t *testing.T) {
+	etag := `"0123456789abcdef"`
+	tests := map[string]bool{
+		`"0123456789abcdef"`:          true,
+		`W/"0123456789abcdef"`:        true,
+		`"other", "0123456789abcdef"`: true,
+		`*`:                           true,
+		`"other"`:                     false,
+		``:                            false,
+		`"0123456789abcdef`:           false,
+	}
+	for ifNoneMatch, want := range tests {
+		if got := etagMatches(ifNoneMatch, etag); got != want {
+			t.Errorf("etagMatches(%q) = %t, want %t", ifNoneMatch, got, want)
+		}
+	}
+}
+
+func TestManifestETag(t *testing.T) {
+	fsys := fstest.MapFS{
+		"index.html":               {Data: []byte("<html></html>")},
+		"main.js":                  {Data: []byte("console.log(1)")},
+		"assets/index-4f3a9c1b.js": {Data: []byte("console.log(2)")},
+	}
+	manifest, err := BuildManifest(fsys, false, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	data, err := manifest.MarshalBinary()
+	if err != nil {
+		t.Fatal(err)
+	}
+	fsys[ManifestFileName] = &fstest.MapFile{Data: data}
+
+	// A rebuild without updating the manifest that keeps the size of an asset passes the validation of the manifest
+	rebuilt := []byte("console.log(3)")
+	fsys["main.js"] = &fstest.MapFile{Data: rebuilt}
+
+	handler, err := NewAssetHandler(assetserver.Options{Assets: fsys}, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if handler.(*assetHandler).manifest == nil {
+		t.Fatal("manifest has not been loaded")
+	}
+
+	tests := map[string]string{
+		"/main.js":                  contentETag(sha256.Sum256(rebuilt)),
+		"/assets/index-4f3a9c1b.js": manifest.Lookup("assets/index-4f3a9c1b.js").ETag(),
+	}
+	for url, want := range tests {
+		rec := httptest.NewRecorder()
+		handler.ServeHTTP(rec, httptest.NewRequest(http.MethodGet, url, nil))
+		if got := rec.Header().Get(HeaderETag); got != want {
+			t.Errorf("%s: ETag %s, want %s", url, got, want)
+		}
+	}
+}
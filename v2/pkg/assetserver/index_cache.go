@@ -0,0 +1,51 @@
+package assetserver
+
+import (
+	"crypto/sha256"
+	"sync"
+)
+
+// maxCachedIndexHTML is the number of processed index.html documents that are cached. An app usually serves a single
+// index.html, but a handler might serve different ones for different routes.
+const maxCachedIndexHTML = 8
+
+// indexHTMLCache caches the processed index.html, keyed by the hash of the source document and the injected scripts.
+// A changed source document gets a new key, so files served from disk are processed again once they change.
+type indexHTMLCache struct {
+	mu      sync.Mutex
+	entries map[[sha256.Size]byte][]byte
+
+	// capacity limits the entries, the cache is cleared once it's full
+	capacity int
+}
+
+// indexHTMLKey returns the cache key for the source document with the plugin scripts injected
+func indexHTMLKey(source []byte, pluginScriptNames []string) [sha256.Size]byte {
+	hash := sha256.New()
+	hash.Write(source)
+	for _, name := range pluginScriptNames {
+		hash.Write([]byte{0})
+		hash.Write([]byte(name))
+	}
+
+	var key [sha256.Size]byte
+	hash.Sum(key[:0])
+	return key
+}
+
+// get returns the processed document, which must not be modified
+func (c *indexHTMLCache) get(key [sha256.Size]byte) ([]byte, bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	content, ok := c.entries[key]
+	return content, ok
+}
+
+func (c *indexHTMLCache) put(key [sha256.Size]byte, content []byte) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if c.entries == nil || len(c.entries) >= c.capacity {
+		c.entries = make(map[[sha256.Size]byte][]byte, c.capacity)
+	}
+	c.entries[key] = content
+}
@@ -0,0 +1,65 @@
+package assetserver
+
+import (
+	"net/http"
+	"net/http/httptest"
+	"strconv"
+	"strings"
+	"testing"
+)
+
+type testRuntimeAssets struct{}
+
+func (testRuntimeAssets) DesktopIPC() []byte       { return []byte("ipc") }
+func (testRuntimeAssets) WebsocketIPC() []byte     { return []byte("ipc") }
+func (testRuntimeAssets) RuntimeDesktopJS() []byte { return []byte("runtime") }
+
+func TestIndexHTMLCache(t *testing.T) {
+	source := `<html><head></head><body>v1</body></html>`
+	handler := http.HandlerFunc(func(rw http.ResponseWriter, req *http.Request) {
+		rw.Header().Set(HeaderContentType, "text/html; charset=utf-8")
+		rw.Header().Set(HeaderContentLength, strconv.Itoa(len(source)))
+		rw.Write([]byte(source))
+	})
+
+	server, err := NewAssetServerWithHandler(handler, "", true, nil, testRuntimeAssets{})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	get := func() string {
+		rec := httptest.NewRecorder()
+		server.ServeHTTP(rec, httptest.NewRequest(http.MethodGet, "/", nil))
+		if rec.Code != http.StatusOK {
+			t.Fatalf("status %d", rec.Code)
+		}
+		return rec.Body.String()
+	}
+
+	first := get()
+	if !strings.Contains(first, runtimeJSPath) || !strings.Contains(first, "v1") {
+		t.Fatalf("unexpected index.html %s", first)
+	}
+	key := indexHTMLKey([]byte(source), nil)
+	if _, ok := server.indexHTMLCache.get(key); !ok {
+		t.Fatal("index.html has not been cached")
+	}
+	if second := get(); second != first {
+		t.Errorf("cached index.html differs: %s", second)
+	}
+
+	// A changed file on disk is processed again
+	source = `<html><head></head><body>v2</body></html>`
+	if changed := get(); !strings.Contains(changed, "v2") {
+		t.Errorf("stale index.html %s", changed)
+	}
+	if _, ok := server.indexHTMLCache.get(key); ok {
+		t.Error("the outdated index.html is still cached")
+	}
+
+	// Adding a plugin changes the key
+	server.AddPluginScript("plugin", "script")
+	if withPlugin := get(); !strings.Contains(withPlugin, server.pluginScriptNames[0]) {
+		t.Errorf("plugin script not injected %s", withPlugin)
+	}
+}
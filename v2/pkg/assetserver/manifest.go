@@ -0,0 +1,451 @@
+package assetserver
+
+import (
+	"bytes"
+	"crypto/sha256"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io"
+	iofs "io/fs"
+	"os"
+	"path"
+	"sort"
+	"strings"
+)
+
+// ManifestFileName is the name of the asset manifest, that `wails build` writes into the embedded asset directories
+const ManifestFileName = "wails-assets.manifest"
+
+const manifestMagic = "WAM1"
+
+var errInvalidManifest = errors.New("invalid asset manifest")
+
+// ManifestEntry describes an asset of the manifest
+type ManifestEntry struct {
+	Path     string
+	Size     int64
+	MimeType string
+	Hash     [sha256.Size]byte
+
+	// Variants are the precompressed variants of the asset
+	Variants []ManifestVariant
+
+	etag string
+}
+
+// ETag returns the strong ETag of the asset, derived from its content hash
+func (e *ManifestEntry) ETag() string {
+	if e.etag == "" {
+		return contentETag(e.Hash)
+	}
+	return e.etag
+}
+
+// ManifestVariant is a precompressed variant of an asset, stored next to the asset with the extension of its encoding
+type ManifestVariant struct {
+	// Encoding is the Content-Encoding of the variant, e.g. `br` or `gzip`
+	Encoding string
+	Path     string
+	Size     int64
+}
+
+// Manifest describes the assets of an asset directory, it's generated at build time. Assets are looked up with a
+// minimal perfect hash, a lookup doesn't allocate or take locks.
+type Manifest struct {
+	// Root is the directory that contains `index.html`, relative to the directory of the manifest
+	Root string
+
+	// entries are ordered by their slot, seeds select the hash function of each bucket
+	entries []ManifestEntry
+	seeds   []uint32
+}
+
+// manifestVariantExtensions are the extensions of precompressed variants, by their Content-Encoding
+var manifestVariantExtensions = map[string]string{
+	"br":   ".br",
+	"gzip": ".gz",
+}
+
+// BuildManifest creates the manifest for the asset directory fsys. Files and directories that start with `.` or `_`
+// are skipped unless includeHidden is set, like they are by `//go:embed` without `all:`. variants are the paths of the
+// precompressed files in fsys that have been written for the current version of their asset, only those become
+// variants. Other precompressed files might belong to an older version of the asset and are kept as plain files.
+func BuildManifest(fsys iofs.FS, includeHidden bool, variants map[string]bool) (*Manifest, error) {
+	root, err := FindPathToFile(fsys, indexHTML)
+	if err != nil {
+		return nil, err
+	}
+	root = path.Clean(root)
+
+	assets, err := iofs.Sub(fsys, root)
+	if err != nil {
+		return nil, err
+	}
+
+	var entries []ManifestEntry
+	files := map[string]bool{}
+	err = iofs.WalkDir(assets, ".", func(filePath string, d iofs.DirEntry, err error) error {
+		if err != nil {
+			return err
+		}
+		if filePath != "." && !includeHidden && (d.Name()[0] == '.' || d.Name()[0] == '_') {
+			if d.IsDir() {
+				return iofs.SkipDir
+			}
+			return nil
+		}
+		if d.IsDir() || (root == "." && filePath == ManifestFileName) {
+			return nil
+		}
+
+		files[filePath] = true
+		entry, err := newManifestEntry(assets, filePath)
+		if err != nil {
+			return err
+		}
+		entries = append(entries, entry)
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	// Precompressed files written for their asset become variants of it, if the asset exists
+	assetEntries := entries[:0]
+	assetVariants := map[string][]ManifestVariant{}
+	for _, entry := range entries {
+		encoding, asset := manifestVariantOf(entry.Path)
+		if encoding != "" && files[asset] && variants[path.Join(root, entry.Path)] {
+			assetVariants[asset] = append(assetVariants[asset], ManifestVariant{Encoding: encoding, Path: entry.Path, Size: entry.Size})
+			continue
+		}
+		assetEntries = append(assetEntries, entry)
+	}
+	for i := range assetEntries {
+		assetEntries[i].Variants = assetVariants[assetEntries[i].Path]
+		sort.Slice(assetEntries[i].Variants, func(a, b int) bool {
+			return assetEntries[i].Variants[a].Encoding < assetEntries[i].Variants[b].Encoding
+		})
+	}
+
+	return newManifest(root, assetEntries)
+}
+
+func manifestVariantOf(filePath string) (encoding string, asset string) {
+	for encoding, ext := range manifestVariantExtensions {
+		if strings.HasSuffix(filePath, ext) {
+			return encoding, strings.TrimSuffix(filePath, ext)
+		}
+	}
+	return "", ""
+}
+
+func newManifestEntry(fsys iofs.FS, filePath string) (ManifestEntry, error) {
+	file, err := fsys.Open(filePath)
+	if err != nil {
+		return ManifestEntry{}, err
+	}
+	defer file.Close()
+
+	hash := sha256.New()
+	var head bytes.Buffer
+	size, err := io.Copy(io.MultiWriter(hash, &limitedWriter{w: &head, n: 512}), file)
+	if err != nil {
+		return ManifestEntry{}, err
+	}
+
+	entry := ManifestEntry{
+		Path:     filePath,
+		Size:     size,
+		MimeType: GetMimetype(filePath, head.Bytes()),
+	}
+	hash.Sum(entry.Hash[:0])
+	return entry, nil
+}
+
+// limitedWriter keeps the first n bytes written to it
+type limitedWriter struct {
+	w io.Writer
+	n int
+}
+
+func (l *limitedWriter) Write(p []byte) (int, error) {
+	if l.n > 0 {
+		keep := p
+		if len(keep) > l.n {
+			keep = keep[:l.n]
+		}
+		l.n -= len(keep)
+		if _, err := l.w.Write(keep); err != nil {
+			return 0, err
+		}
+	}
+	return len(p), nil
+}
+
+// newManifest places the entries with a minimal perfect hash. Keys are distributed to buckets of about 4 keys and
+// the buckets are placed from the largest to the smallest by searching a seed that maps their keys to free slots.
+func newManifest(root string, entries []ManifestEntry) (*Manifest, error) {
+	count := len(entries)
+	result := &Manifest{Root: root, entries: make([]ManifestEntry, count)}
+	if count == 0 {
+		return result, nil
+	}
+
+	buckets := make([][]int, (count+3)/4)
+	for i, entry := range entries {
+		b := manifestHash(0, entry.Path) % uint64(len(buckets))
+		buckets[b] = append(buckets[b], i)
+	}
+
+	order := make([]int, len(buckets))
+	for i := range order {
+		order[i] = i
+	}
+	sort.SliceStable(order, func(a, b int) bool { return len(buckets[order[a]]) > len(buckets[order[b]]) })
+
+	result.seeds = make([]uint32, len(buckets))
+	occupied := make([]bool, count)
+	slots := make([]uint64, 0, 8)
+	for _, b := range order {
+		bucket := buckets[b]
+		if len(bucket) == 0 {
+			break
+		}
+
+		placed := false
+		for seed := uint32(1); seed < 1<<24 && !placed; seed++ {
+			slots = slots[:0]
+			placed = true
+			for _, i := range bucket {
+				slot := manifestHash(seed, entries[i].Path) % uint64(count)
+				if occupied[slot] || containsSlot(slots, slot) {
+					placed = false
+					break
+				}
+				slots = append(slots, slot)
+			}
+			if placed {
+				result.seeds[b] = seed
+				for j, i := range bucket {
+					occupied[slots[j]] = true
+					result.entries[slots[j]] = entries[i]
+				}
+			}
+		}
+		if !placed {
+			return nil, fmt.Errorf("unable to build the asset manifest, duplicate paths?")
+		}
+	}
+	return result, nil
+}
+
+func containsSlot(slots []uint64, slot uint64) bool {
+	for _, s := range slots {
+		if s == slot {
+			return true
+		}
+	}
+	return false
+}
+
+// manifestHash is a seeded FNV-1a hash with a final avalanche, it must never change as it's part of the format
+func manifestHash(seed uint32, key string) uint64 {
+	h := uint64(14695981039346656037) ^ (uint64(seed) * 0x9e3779b97f4a7c15)
+	for i := 0; i < len(key); i++ {
+		h ^= uint64(key[i])
+		h *= 1099511628211
+	}
+	h ^= h >> 33
+	h *= 0xff51afd7ed558ccd
+	h ^= h >> 33
+	h *= 0xc4ceb9fe1a85ec53
+	h ^= h >> 33
+	return h
+}
+
+// Lookup returns the entry of the asset path, relative to Root, or nil if the asset is not in the manifest
+func (m *Manifest) Lookup(assetPath string) *ManifestEntry {
+	if len(m.entries) == 0 {
+		return nil
+	}
+
+	b := manifestHash(0, assetPath) % uint64(len(m.seeds))
+	entry := &m.entries[manifestHash(m.seeds[b], assetPath)%uint64(len(m.entries))]
+	if entry.Path != assetPath {
+		return nil
+	}
+	return entry
+}
+
+// Entries returns all entries of the manifest
+func (m *Manifest) Entries() []ManifestEntry {
+	return m.entries
+}
+
+// MarshalBinary encodes the manifest as length prefixed fields
+func (m *Manifest) MarshalBinary() ([]byte, error) {
+	var buf []byte
+	putString := func(s string) {
+		buf = binary.AppendUvarint(buf, uint64(len(s)))
+		buf = append(buf, s...)
+	}
+
+	buf = append(buf, manifestMagic...)
+	putString(m.Root)
+	buf = binary.AppendUvarint(buf, uint64(len(m.entries)))
+	buf = binary.AppendUvarint(buf, uint64(len(m.seeds)))
+	for _, seed := range m.seeds {
+		buf = binary.AppendUvarint(buf, uint64(seed))
+	}
+	for _, entry := range m.entries {
+		putString(entry.Path)
+		buf = binary.AppendUvarint(buf, uint64(entry.Size))
+		putString(entry.MimeType)
+		buf = append(buf, entry.Hash[:]...)
+		buf = binary.AppendUvarint(buf, uint64(len(entry.Variants)))
+		for _, variant := range entry.Variants {
+			putString(variant.Encoding)
+			putString(variant.Path)
+			buf = binary.AppendUvarint(buf, uint64(variant.Size))
+		}
+	}
+	return buf, nil
+}
+
+// UnmarshalBinary decodes a manifest encoded by MarshalBinary
+func (m *Manifest) UnmarshalBinary(data []byte) error {
+	if !bytes.HasPrefix(data, []byte(manifestMagic)) {
+		return errInvalidManifest
+	}
+	data = data[len(manifestMagic):]
+
+	var err error
+	getUint := func() uint64 {
+		value, n := binary.Uvarint(data)
+		if n <= 0 {
+			err = errInvalidManifest
+			return 0
+		}
+		data = data[n:]
+		return value
+	}
+	getBytes := func(length uint64) []byte {
+		if err != nil || length > uint64(len(data)) {
+			err = errInvalidManifest
+			return nil
+		}
+		result := data[:length]
+		data = data[length:]
+		return result
+	}
+	getString := func() string {
+		return string(getBytes(getUint()))
+	}
+
+	result := Manifest{Root: getString()}
+	count, seeds := getUint(), getUint()
+	if err != nil || count > uint64(len(data)) || seeds > uint64(len(data)) || (count > 0) != (seeds > 0) {
+		return errInvalidManifest
+	}
+
+	result.seeds = make([]uint32, seeds)
+	for i := range result.seeds {
+		result.seeds[i] = uint32(getUint())
+	}
+	result.entries = make([]ManifestEntry, count)
+	for i := range result.entries {
+		entry := &result.entries[i]
+		entry.Path = getString()
+		entry.Size = int64(getUint())
+		entry.MimeType = getString()
+		copy(entry.Hash[:], getBytes(sha256.Size))
+		entry.etag = contentETag(entry.Hash)
+
+		variants := getUint()
+		if err != nil || variants > uint64(len(data)) {
+			return errInvalidManifest
+		}
+		if variants > 0 {
+			entry.Variants = make([]ManifestVariant, variants)
+		}
+		for j := range entry.Variants {
+			entry.Variants[j] = ManifestVariant{Encoding: getString(), Path: getString(), Size: int64(getUint())}
+		}
+	}
+	if err != nil || len(data) != 0 {
+		return errInvalidManifest
+	}
+
+	*m = result
+	return nil
+}
+
+// LoadManifest loads the manifest from the asset FS and returns it with the directory it was found in. The manifest
+// is only looked up in the chain of single directories at the top of fsys, which is where `//go:embed` puts the
+// embedded directory. os.ErrNotExist is returned if there's no manifest.
+func LoadManifest(fsys iofs.FS) (*Manifest, string, error) {
+	dir := "."
+	for {
+		data, err := iofs.ReadFile(fsys, path.Join(dir, ManifestFileName))
+		if err == nil {
+			manifest := &Manifest{}
+			if err := manifest.UnmarshalBinary(data); err != nil {
+				return nil, "", err
+			}
+			if err := manifest.validate(fsys, dir); err != nil {
+				return nil, "", err
+			}
+			return manifest, dir, nil
+		}
+		if !errors.Is(err, os.ErrNotExist) {
+			return nil, "", err
+		}
+
+		entries, err := iofs.ReadDir(fsys, dir)
+		if err != nil {
+			return nil, "", err
+		}
+		if len(entries) != 1 || !entries[0].IsDir() {
+			return nil, "", os.ErrNotExist
+		}
+		dir = path.Join(dir, entries[0].Name())
+	}
+}
+
+// validate makes sure the manifest belongs to the assets, it might be stale if the app has been compiled without
+// `wails build` after the frontend changed
+func (m *Manifest) validate(fsys iofs.FS, dir string) error {
+	root := path.Join(dir, m.Root)
+	for _, entry := range m.entries {
+		stat, err := iofs.Stat(fsys, path.Join(root, entry.Path))
+		if err != nil {
+			return fmt.Errorf("asset manifest is stale: %w", err)
+		}
+		if stat.Size() != entry.Size {
+			return fmt.Errorf("asset manifest is stale: size of '%s' changed", entry.Path)
+		}
+
+		for _, variant := range entry.Variants {
+			stat, err := iofs.Stat(fsys, path.Join(root, variant.Path))
+			if err != nil {
+				return fmt.Errorf("asset manifest is stale: %w", err)
+			}
+			if stat.Size() != variant.Size {
+				return fmt.Errorf("asset manifest is stale: size of '%s' changed", variant.Path)
+			}
+		}
+	}
+
+	if index := m.Lookup(indexHTML); index != nil {
+		data, err := iofs.ReadFile(fsys, path.Join(root, indexHTML))
+		if err != nil {
+			return err
+		}
+		if sha256.Sum256(data) != index.Hash {
+			return fmt.Errorf("asset manifest is stale: '%s' changed", indexHTML)
+		}
+	}
+	return nil
+}
@@ -0,0 +1,115 @@
+package assetserver
+
+import (
+	"fmt"
+	"io/fs"
+	"testing"
+	"testing/fstest"
+)
+
+func TestManifest(t *testing.T) {
+	fsys := fstest.MapFS{
+		"frontend/dist/index.html":        {Data: []byte("<html></html>")},
+		"frontend/dist/main.js":           {Data: []byte("console.log(1)")},
+		"frontend/dist/main.js.br":        {Data: []byte("br")},
+		"frontend/dist/main.js.gz":        {Data: []byte("gzip")},
+		"frontend/dist/other.gz":          {Data: []byte("no asset")},
+		"frontend/dist/_hidden.js":        {Data: []byte("hidden")},
+		"frontend/dist/.vite/info":        {Data: []byte("hidden")},
+		"frontend/dist/assets/app.css":    {Data: []byte("body{}")},
+		"frontend/dist/assets/app.css.gz": {Data: []byte("old gzip")},
+	}
+	for i := 0; i < 100; i++ {
+		fsys[fmt.Sprintf("frontend/dist/assets/chunk-%d.js", i)] = &fstest.MapFile{Data: []byte(fmt.Sprint(i))}
+	}
+
+	// The manifest is built for the embedded directory `frontend`, which contains the assets in `dist`
+	embedded, err := fs.Sub(fsys, "frontend")
+	if err != nil {
+		t.Fatal(err)
+	}
+	// assets/app.css.gz hasn't been written by the build
+	built, err := BuildManifest(embedded, false, map[string]bool{"dist/main.js.br": true, "dist/main.js.gz": true})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if built.Root != "dist" {
+		t.Fatalf("root is %q", built.Root)
+	}
+
+	data, err := built.MarshalBinary()
+	if err != nil {
+		t.Fatal(err)
+	}
+	fsys["frontend/"+ManifestFileName] = &fstest.MapFile{Data: data}
+
+	manifest, dir, err := LoadManifest(fsys)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if dir != "frontend" {
+		t.Fatalf("manifest found in %q", dir)
+	}
+
+	if got := len(manifest.Entries()); got != 105 {
+		t.Errorf("got %d entries, want 105", got)
+	}
+	for _, assetPath := range []string{"index.html", "main.js", "other.gz", "assets/app.css", "assets/app.css.gz", "assets/chunk-42.js"} {
+		if entry := manifest.Lookup(assetPath); entry == nil || entry.Path != assetPath {
+			t.Errorf("%s not found", assetPath)
+		}
+	}
+	for _, assetPath := range []string{"main.js.br", "_hidden.js", ".vite/info", "missing.js", "", ManifestFileName} {
+		if entry := manifest.Lookup(assetPath); entry != nil {
+			t.Errorf("%s found", assetPath)
+		}
+	}
+
+	entry := manifest.Lookup("main.js")
+	if entry.Size != 14 || entry.MimeType != "text/javascript; charset=utf-8" {
+		t.Errorf("unexpected entry %+v", entry)
+	}
+	if len(entry.Variants) != 2 || entry.Variants[0].Encoding != "br" || entry.Variants[1].Path != "main.js.gz" {
+		t.Errorf("unexpected variants %+v", entry.Variants)
+	}
+	if entry := manifest.Lookup("assets/app.css"); len(entry.Variants) != 0 {
+		t.Errorf("unexpected variants %+v", entry.Variants)
+	}
+
+	// A changed variant makes the manifest stale
+	variant := fsys["frontend/dist/main.js.gz"]
+	fsys["frontend/dist/main.js.gz"] = &fstest.MapFile{Data: []byte("new gzip")}
+	if _, _, err := LoadManifest(fsys); err == nil {
+		t.Error("manifest with a stale variant has been loaded")
+	}
+	fsys["frontend/dist/main.js.gz"] = variant
+
+	// A changed asset makes the manifest stale
+	fsys["frontend/dist/index.html"] = &fstest.MapFile{Data: []byte("<html>!</html>")}
+	if _, _, err := LoadManifest(fsys); err == nil {
+		t.Error("stale manifest has been loaded")
+	}
+
+	if err := (&Manifest{}).UnmarshalBinary(data[:len(data)-1]); err == nil {
+		t.Error("truncated manifest has been decoded")
+	}
+}
+
+func BenchmarkManifestLookup(b *testing.B) {
+	entries := make([]ManifestEntry, 300)
+	for i := range entries {
+		entries[i].Path = fmt.Sprintf("assets/module-%d.js", i)
+	}
+	manifest, err := newManifest(".", entries)
+	if err != nil {
+		b.Fatal(err)
+	}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if manifest.Lookup(entries[i%len(entries)].Path) == nil {
+			b.Fatal("not found")
+		}
+	}
+}
@@ -0,0 +1,83 @@
+package assetserver
+
+import (
+	"io"
+	"mime"
+	"net/http"
+	"path"
+	"strconv"
+	"strings"
+	"time"
+)
+
+// mediaChunkSize is the maximum size of the response to an open ended range request for audio or video
+const mediaChunkSize = 4 << 20
+
+const headerRange = "Range"
+
+// ServeMedia replies to the request with the content like http.ServeContent, including conditional and range
+// requests. Open ended range requests for audio and video, like the `bytes=1000-` sent by media elements, are answered
+// with a partial response of at most 4 MiB. So a seek doesn't have to wait for an earlier response that spans the
+// rest of the file, and the webview can read every response without copying it through a pipe.
+//
+// The Content-Type is derived from the extension of the name, unless it has been set before.
+//
+// On Linux large regions of an *os.File content are memory mapped and WebKit reads them after ServeMedia has returned.
+// The file must not be truncated or rewritten in place until then, reading a truncated mapping crashes the app with
+// SIGBUS. Pass a reader that wraps the file, like an io.SectionReader, for files that might change while being served.
+func ServeMedia(rw http.ResponseWriter, req *http.Request, name string, modtime time.Time, content io.ReadSeeker) {
+	size, err := content.Seek(0, io.SeekEnd)
+	if err == nil {
+		_, err = content.Seek(0, io.SeekStart)
+	}
+	if err != nil {
+		http.Error(rw, "seeker can't seek", http.StatusInternalServerError)
+		return
+	}
+
+	header := rw.Header()
+	if _, haveType := header[HeaderContentType]; !haveType {
+		if contentType := mime.TypeByExtension(path.Ext(name)); contentType != "" {
+			header.Set(HeaderContentType, contentType)
+		}
+	}
+	serveContent(rw, req, name, modtime, size, content)
+}
+
+// serveContent serves the content of the given size with http.ServeContent, open ended range requests for media are
+// limited to mediaChunkSize
+func serveContent(rw http.ResponseWriter, req *http.Request, name string, modtime time.Time, size int64, content io.ReadSeeker) {
+	if size > mediaChunkSize && isMediaType(rw.Header().Get(HeaderContentType)) {
+		if chunk, ok := mediaChunkRange(req.Header.Get(headerRange), size); ok {
+			chunked := *req
+			chunked.Header = req.Header.Clone()
+			chunked.Header.Set(headerRange, chunk)
+			req = &chunked
+		}
+	}
+
+	http.ServeContent(rw, req, name, modtime, content)
+}
+
+func isMediaType(contentType string) bool {
+	return strings.HasPrefix(contentType, "video/") || strings.HasPrefix(contentType, "audio/")
+}
+
+// mediaChunkRange returns the limited range for a single open ended range `bytes=<start>-`, ok is false if the range
+// doesn't need to be limited
+func mediaChunkRange(rangeHeader string, size int64) (string, bool) {
+	spec, found := strings.CutPrefix(rangeHeader, "bytes=")
+	if !found {
+		return "", false
+	}
+	start, ok := strings.CutSuffix(strings.TrimSpace(spec), "-")
+	if !ok || start == "" {
+		return "", false
+	}
+
+	first, err := strconv.ParseInt(start, 10, 64)
+	if err != nil || first < 0 || size-first <= mediaChunkSize {
+		return "", false
+	}
+	return "bytes=" + start + "-" + strconv.FormatInt(first+mediaChunkSize-1, 10), true
+}
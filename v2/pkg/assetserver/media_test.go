@@ -0,0 +1,227 @@
+package assetserver
+
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"math/rand"
+	"net/http"
+	"net/http/httptest"
+	"os"
+	"path/filepath"
+	"testing"
+	"testing/fstest"
+	"time"
+
+	"github.com/wailsapp/wails/v2/pkg/options/assetserver"
+)
+
+func TestServeMedia(t *testing.T) {
+	const size = 10 << 20
+	content := bytes.NewReader(make([]byte, size))
+
+	tests := []struct {
+		rangeHeader   string
+		code          int
+		contentRange  string
+		contentLength string
+	}{
+		{"", http.StatusOK, "", "10485760"},
+		{"bytes=0-", http.StatusPartialContent, "bytes 0-4194303/10485760", "4194304"},
+		{"bytes=100-", http.StatusPartialContent, "bytes 100-4194403/10485760", "4194304"},
+		{"bytes=8388608-", http.StatusPartialContent, "bytes 8388608-10485759/10485760", "2097152"},
+		{"bytes=100-199", http.StatusPartialContent, "bytes 100-199/10485760", "100"},
+		{"bytes=-10", http.StatusPartialContent, "bytes 10485750-10485759/10485760", "10"},
+		{"bytes=20000000-", http.StatusRequestedRangeNotSatisfiable, "bytes */10485760", ""},
+	}
+
+	for _, tt := range tests {
+		req := httptest.NewRequest(http.MethodGet, "/movie.mp4", nil)
+		if tt.rangeHeader != "" {
+			req.Header.Set(headerRange, tt.rangeHeader)
+		}
+		rec := httptest.NewRecorder()
+		ServeMedia(rec, req, "movie.mp4", time.Time{}, content)
+
+		res := rec.Result()
+		if res.StatusCode != tt.code {
+			t.Errorf("%q: status %d, want %d", tt.rangeHeader, res.StatusCode, tt.code)
+		}
+		if got := res.Header.Get("Content-Range"); got != tt.contentRange {
+			t.Errorf("%q: Content-Range %q, want %q", tt.rangeHeader, got, tt.contentRange)
+		}
+		if tt.contentLength != "" {
+			if got := res.Header.Get(HeaderContentLength); got != tt.contentLength || fmt.Sprint(rec.Body.Len()) != got {
+				t.Errorf("%q: Content-Length %q with %d bytes, want %s", tt.rangeHeader, got, rec.Body.Len(), tt.contentLength)
+			}
+		}
+		if got := res.Header.Get(HeaderContentType); got != "video/mp4" && tt.code != http.StatusRequestedRangeNotSatisfiable {
+			t.Errorf("%q: Content-Type %q", tt.rangeHeader, got)
+		}
+	}
+
+	// Other content isn't split into chunks
+	req := httptest.NewRequest(http.MethodGet, "/data.bin", nil)
+	req.Header.Set(headerRange, "bytes=0-")
+	rec := httptest.NewRecorder()
+	ServeMedia(rec, req, "data.bin", time.Time{}, content)
+	if got := rec.Header().Get("Content-Range"); got != "bytes 0-10485759/10485760" {
+		t.Errorf("Content-Range %q", got)
+	}
+}
+
+// fileReaderFromWriter records if ReadFrom gets the region of an *os.File, which the Linux webview memory maps
+type fileReaderFromWriter struct {
+	discardResponseWriter
+	file bool
+}
+
+func (rw *fileReaderFromWriter) ReadFrom(r io.Reader) (int64, error) {
+	if limited, ok := r.(*io.LimitedReader); ok {
+		_, rw.file = limited.R.(*os.File)
+	}
+	return rw.discardResponseWriter.ReadFrom(r)
+}
+
+func TestAssetFilesAreNotMapped(t *testing.T) {
+	dir := t.TempDir()
+	for name, data := range map[string][]byte{"index.html": []byte("<html></html>"), "video.mp4": make([]byte, 8<<20)} {
+		if err := os.WriteFile(filepath.Join(dir, name), data, 0o644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	handler, err := NewAssetHandler(assetserver.Options{Assets: os.DirFS(dir)}, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	rw := &fileReaderFromWriter{discardResponseWriter: discardResponseWriter{header: http.Header{}}}
+	handler.ServeHTTP(rw, httptest.NewRequest(http.MethodGet, "/video.mp4", nil))
+	if rw.written != 8<<20 || rw.file {
+		t.Errorf("wrote %d bytes, file passed to ReadFrom: %v", rw.written, rw.file)
+	}
+
+	// ServeMedia passes the file on
+	file, err := os.Open(filepath.Join(dir, "video.mp4"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer file.Close()
+	rw = &fileReaderFromWriter{discardResponseWriter: discardResponseWriter{header: http.Header{}}}
+	ServeMedia(rw, httptest.NewRequest(http.MethodGet, "/video.mp4", nil), "video.mp4", time.Time{}, file)
+	if !rw.file {
+		t.Error("file not passed to ReadFrom")
+	}
+}
+
+// BenchmarkMediaThroughput plays a 64 MiB video from start to end like a media element does, by requesting the rest of
+// the file from the end of the last response.
+func BenchmarkMediaThroughput(b *testing.B) {
+	for _, media := range newMediaHandlers(b, 64<<20) {
+		handler := media.handler
+		b.Run(media.name, func(b *testing.B) {
+			b.SetBytes(64 << 20)
+			for i := 0; i < b.N; i++ {
+				for offset := int64(0); offset < 64<<20; {
+					offset += requestMedia(b, handler, offset)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkMediaSeek measures the latency of a seek to a random position of a 64 MiB video, until the response has
+// been written
+func BenchmarkMediaSeek(b *testing.B) {
+	for _, media := range newMediaHandlers(b, 64<<20) {
+		handler := media.handler
+		b.Run(media.name, func(b *testing.B) {
+			offsets := rand.New(rand.NewSource(1))
+			for i := 0; i < b.N; i++ {
+				requestMedia(b, handler, offsets.Int63n(64<<20))
+			}
+		})
+	}
+}
+
+type mediaHandler struct {
+	name    string
+	handler http.Handler
+}
+
+// newMediaHandlers returns AssetHandlers that serve a video from an embedded FS and from disk, and a handler that
+// serves it from disk with ServeMedia
+func newMediaHandlers(b *testing.B, size int) []mediaHandler {
+	video := make([]byte, size)
+	rand.New(rand.NewSource(1)).Read(video)
+	copy(video, "\x00\x00\x00\x18ftypmp42\x00\x00\x00\x00mp42isom")
+	index := []byte("<html></html>")
+
+	embedded, err := NewAssetHandler(assetserver.Options{Assets: fstest.MapFS{
+		"index.html": {Data: index},
+		"video.mp4":  {Data: video},
+	}}, nil)
+	if err != nil {
+		b.Fatal(err)
+	}
+
+	dir := b.TempDir()
+	for name, data := range map[string][]byte{"index.html": index, "video.mp4": video} {
+		if err := os.WriteFile(filepath.Join(dir, name), data, 0o644); err != nil {
+			b.Fatal(err)
+		}
+	}
+	disk, err := NewAssetHandler(assetserver.Options{Assets: os.DirFS(dir)}, nil)
+	if err != nil {
+		b.Fatal(err)
+	}
+
+	// ServeMedia gets the *os.File, which the Linux webview memory maps
+	serveMedia := http.HandlerFunc(func(rw http.ResponseWriter, req *http.Request) {
+		file, err := os.Open(filepath.Join(dir, "video.mp4"))
+		if err != nil {
+			http.Error(rw, err.Error(), http.StatusInternalServerError)
+			return
+		}
+		defer file.Close()
+		ServeMedia(rw, req, "video.mp4", time.Time{}, file)
+	})
+
+	return []mediaHandler{{"embedded", embedded}, {"disk", disk}, {"ServeMedia", serveMedia}}
+}
+
+// requestMedia requests the video from the offset on and returns the size of the response
+func requestMedia(b *testing.B, handler http.Handler, offset int64) int64 {
+	req := httptest.NewRequest(http.MethodGet, "/video.mp4", nil)
+	req.Header.Set(headerRange, fmt.Sprintf("bytes=%d-", offset))
+	rw := &discardResponseWriter{header: http.Header{}}
+	handler.ServeHTTP(rw, req)
+	if rw.code != http.StatusPartialContent || rw.written == 0 {
+		b.Fatalf("status %d with %d bytes", rw.code, rw.written)
+	}
+	return rw.written
+}
+
+type discardResponseWriter struct {
+	header  http.Header
+	code    int
+	written int64
+}
+
+func (rw *discardResponseWriter) Header() http.Header { return rw.header }
+
+func (rw *discardResponseWriter) WriteHeader(code int) { rw.code = code }
+
+func (rw *discardResponseWriter) Write(buf []byte) (int, error) {
+	if rw.code == 0 {
+		rw.code = http.StatusOK
+	}
+	rw.written += int64(len(buf))
+	return len(buf), nil
+}
+
+func (rw *discardResponseWriter) ReadFrom(r io.Reader) (int64, error) {
+	n, err := io.Copy(io.Discard, r)
+	rw.written += n
+	return n, err
+}
@@ -0,0 +1,283 @@
+package assetserver
+
+import (
+	"net/http"
+	"net/url"
+	"path"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/wailsapp/wails/v2/pkg/assetserver/webview"
+)
+
+// RequestClass is the class of a webview request, it's derived from the destination of the request and the MIME type
+// of the requested resource
+type RequestClass int
+
+const (
+	RequestClassDocument RequestClass = iota
+	RequestClassStyle
+	RequestClassScript
+	RequestClassFont
+	RequestClassImage
+	RequestClassMedia
+	RequestClassOther
+
+	numRequestClasses
+)
+
+var requestClassNames = [numRequestClasses]string{"document", "style", "script", "font", "image", "media", "other"}
+
+func (c RequestClass) String() string {
+	if c < 0 || c >= numRequestClasses {
+		return "unknown"
+	}
+	return requestClassNames[c]
+}
+
+// requestClassWorkers are the workers reserved for each class. Other requests, like fetch calls of the app, might be
+// long polls, so the class has enough workers for the polls of an app next to its short calls.
+var requestClassWorkers = [numRequestClasses]int{
+	RequestClassDocument: 2,
+	RequestClassStyle:    4,
+	RequestClassScript:   6,
+	RequestClassFont:     2,
+	RequestClassImage:    4,
+	RequestClassMedia:    4,
+	RequestClassOther:    16,
+}
+
+// requestExclusiveClasses only use their reserved workers. Their requests may run for a long time, like streamed media
+// or long polls, and would hold on to the shared workers.
+var requestExclusiveClasses = [numRequestClasses]bool{
+	RequestClassMedia: true,
+	RequestClassOther: true,
+}
+
+// requestSharedWorkers are the workers shared between the other classes once their reserved workers are busy
+const requestSharedWorkers = 4
+
+// requestDestinationClasses maps the Sec-Fetch-Dest header to the class of the request
+var requestDestinationClasses = map[string]RequestClass{
+	"document":      RequestClassDocument,
+	"iframe":        RequestClassDocument,
+	"frame":         RequestClassDocument,
+	"style":         RequestClassStyle,
+	"script":        RequestClassScript,
+	"worker":        RequestClassScript,
+	"sharedworker":  RequestClassScript,
+	"serviceworker": RequestClassScript,
+	"font":          RequestClassFont,
+	"image":         RequestClassImage,
+	"audio":         RequestClassMedia,
+	"video":         RequestClassMedia,
+	"track":         RequestClassMedia,
+	"empty":         RequestClassOther,
+}
+
+// requestExtensionClasses maps the extension of the requested path to the class of the request
+var requestExtensionClasses = map[string]RequestClass{
+	".htm":   RequestClassDocument,
+	".html":  RequestClassDocument,
+	".css":   RequestClassStyle,
+	".js":    RequestClassScript,
+	".mjs":   RequestClassScript,
+	".wasm":  RequestClassScript,
+	".eot":   RequestClassFont,
+	".otf":   RequestClassFont,
+	".ttf":   RequestClassFont,
+	".woff":  RequestClassFont,
+	".woff2": RequestClassFont,
+	".avif":  RequestClassImage,
+	".bmp":   RequestClassImage,
+	".gif":   RequestClassImage,
+	".ico":   RequestClassImage,
+	".jpeg":  RequestClassImage,
+	".jpg":   RequestClassImage,
+	".png":   RequestClassImage,
+	".svg":   RequestClassImage,
+	".webp":  RequestClassImage,
+	".flac":  RequestClassMedia,
+	".m4a":   RequestClassMedia,
+	".mov":   RequestClassMedia,
+	".mp3":   RequestClassMedia,
+	".mp4":   RequestClassMedia,
+	".ogg":   RequestClassMedia,
+	".wav":   RequestClassMedia,
+	".webm":  RequestClassMedia,
+}
+
+// classifyRequest returns the class of the request. The Sec-Fetch-Dest header is used if WebKit sends it, otherwise
+// the class is derived from the extension of the path or the Accept header.
+func classifyRequest(uri string, header http.Header) RequestClass {
+	if class, ok := requestDestinationClasses[header.Get("Sec-Fetch-Dest")]; ok {
+		return class
+	}
+
+	if u, err := url.Parse(uri); err == nil {
+		if u.Path == "" || strings.HasSuffix(u.Path, "/") {
+			return RequestClassDocument
+		}
+		if class, ok := requestExtensionClasses[strings.ToLower(path.Ext(u.Path))]; ok {
+			return class
+		}
+	}
+
+	accept := header.Get("Accept")
+	switch {
+	case strings.HasPrefix(accept, "text/html"):
+		return RequestClassDocument
+	case strings.HasPrefix(accept, "text/css"):
+		return RequestClassStyle
+	case strings.HasPrefix(accept, "image/"):
+		return RequestClassImage
+	}
+	return RequestClassOther
+}
+
+// RequestClassStats are the metrics of the webview requests of a class. The queue time is the time a request waited
+// for a worker, the service time is the time it took to process it.
+type RequestClassStats struct {
+	Class          RequestClass
+	Requests       uint64
+	QueueTime      time.Duration
+	MaxQueueTime   time.Duration
+	ServiceTime    time.Duration
+	MaxServiceTime time.Duration
+}
+
+func (s *RequestClassStats) add(queueTime time.Duration, serviceTime time.Duration) {
+	s.Requests++
+	s.QueueTime += queueTime
+	s.ServiceTime += serviceTime
+	if queueTime > s.MaxQueueTime {
+		s.MaxQueueTime = queueTime
+	}
+	if serviceTime > s.MaxServiceTime {
+		s.MaxServiceTime = serviceTime
+	}
+}
+
+// requestScheduler processes the webview requests by their class. Every class has its own queue and reserved
+// workers, so large images can't delay the scripts and styles the page needs for rendering. Once the reserved workers
+// of a class are busy, its requests may use one of the shared workers, which are handed out round robin between the
+// classes that have queued requests. The requestExclusiveClasses never use the shared workers.
+type requestScheduler struct {
+	process func(webview.Request)
+
+	mu            sync.Mutex
+	classes       [numRequestClasses]requestClassQueue
+	sharedWorkers int
+	sharedBusy    int
+	nextShared    RequestClass
+}
+
+type requestClassQueue struct {
+	queue     *ringqueue[scheduledRequest]
+	workers   int
+	busy      int
+	exclusive bool
+	stats     RequestClassStats
+}
+
+type scheduledRequest struct {
+	req    webview.Request
+	queued time.Time
+}
+
+func newRequestScheduler(process func(webview.Request), workers [numRequestClasses]int, sharedWorkers int) *requestScheduler {
+	s := &requestScheduler{
+		process:       process,
+		sharedWorkers: sharedWorkers,
+	}
+	for class := range s.classes {
+		s.classes[class] = requestClassQueue{
+			queue:     newRingqueue[scheduledRequest](8),
+			workers:   workers[class],
+			exclusive: requestExclusiveClasses[class],
+			stats:     RequestClassStats{Class: RequestClass(class)},
+		}
+	}
+	return s
+}
+
+// Schedule processes the request as soon as a worker for its class is available
+func (s *requestScheduler) Schedule(req webview.Request, class RequestClass) {
+	r := scheduledRequest{req: req, queued: time.Now()}
+
+	s.mu.Lock()
+	q := &s.classes[class]
+	shared := false
+	switch {
+	case q.busy < q.workers:
+		q.busy++
+	case !q.exclusive && s.sharedBusy < s.sharedWorkers:
+		s.sharedBusy++
+		shared = true
+	default:
+		q.queue.Add(r)
+		s.mu.Unlock()
+		return
+	}
+	s.mu.Unlock()
+
+	go s.run(class, shared, r)
+}
+
+// run processes requests until there's no queued request left for the worker
+func (s *requestScheduler) run(class RequestClass, shared bool, r scheduledRequest) {
+	for {
+		start := time.Now()
+		s.process(r.req)
+		serviceTime := time.Since(start)
+
+		s.mu.Lock()
+		s.classes[class].stats.add(start.Sub(r.queued), serviceTime)
+
+		var ok bool
+		if shared {
+			class, r, ok = s.nextSharedLocked()
+			if !ok {
+				s.sharedBusy--
+			}
+		} else {
+			r, ok = s.classes[class].queue.Remove()
+			if !ok {
+				s.classes[class].busy--
+			}
+		}
+		s.mu.Unlock()
+
+		if !ok {
+			return
+		}
+	}
+}
+
+// nextSharedLocked returns the next queued request for a shared worker, the classes take turns
+func (s *requestScheduler) nextSharedLocked() (RequestClass, scheduledRequest, bool) {
+	for i := RequestClass(0); i < numRequestClasses; i++ {
+		class := (s.nextShared + i) % numRequestClasses
+		if s.classes[class].exclusive {
+			continue
+		}
+		if r, ok := s.classes[class].queue.Remove(); ok {
+			s.nextShared = (class + 1) % numRequestClasses
+			return class, r, true
+		}
+	}
+	return 0, scheduledRequest{}, false
+}
+
+// Stats returns the metrics of all classes
+func (s *requestScheduler) Stats() []RequestClassStats {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	stats := make([]RequestClassStats, numRequestClasses)
+	for class := range s.classes {
+		stats[class] = s.classes[class].stats
+	}
+	return stats
+}
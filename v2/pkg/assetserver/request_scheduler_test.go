@@ -0,0 +1,159 @@
+package assetserver
+
+import (
+	"io"
+	"net/http"
+	"testing"
+	"time"
+
+	"github.com/wailsapp/wails/v2/pkg/assetserver/webview"
+)
+
+type testRequest struct {
+	uri    string
+	header http.Header
+}
+
+func (r *testRequest) URL() (string, error)             { return r.uri, nil }
+func (r *testRequest) Method() (string, error)          { return http.MethodGet, nil }
+func (r *testRequest) Header() (http.Header, error)     { return r.header, nil }
+func (r *testRequest) Body() (io.ReadCloser, error)     { return nil, nil }
+func (r *testRequest) Response() webview.ResponseWriter { return nil }
+func (r *testRequest) Close() error                     { return nil }
+
+func TestClassifyRequest(t *testing.T) {
+	tests := []struct {
+		uri    string
+		header http.Header
+		want   RequestClass
+	}{
+		{"wails://wails/", nil, RequestClassDocument},
+		{"wails://wails", nil, RequestClassDocument},
+		{"wails://wails/assets/index-4f3a9c1b.js?v=1", nil, RequestClassScript},
+		{"wails://wails/assets/app.CSS", nil, RequestClassStyle},
+		{"wails://wails/fonts/inter.woff2", nil, RequestClassFont},
+		{"wails://wails/hero.webp", nil, RequestClassImage},
+		{"wails://wails/intro.mp4", nil, RequestClassMedia},
+		{"wails://wails/api/items", nil, RequestClassOther},
+		{"wails://wails/api/avatar", http.Header{"Accept": {"image/avif,image/webp,*/*"}}, RequestClassImage},
+		{"wails://wails/app.js", http.Header{"Sec-Fetch-Dest": {"worker"}}, RequestClassScript},
+		{"wails://wails/data.js", http.Header{"Sec-Fetch-Dest": {"empty"}}, RequestClassOther},
+	}
+
+	for _, tt := range tests {
+		if got := classifyRequest(tt.uri, tt.header); got != tt.want {
+			t.Errorf("%s %v: got %s, want %s", tt.uri, tt.header, got, tt.want)
+		}
+	}
+}
+
+func TestRequestScheduler(t *testing.T) {
+	release := make(chan struct{})
+	processed := make(chan string, 100)
+	process := func(req webview.Request) {
+		uri, _ := req.URL()
+		if classifyRequest(uri, nil) == RequestClassImage {
+			<-release
+		}
+		processed <- uri
+	}
+
+	var workers [numRequestClasses]int
+	workers[RequestClassImage] = 2
+	workers[RequestClassScript] = 1
+	s := newRequestScheduler(process, workers, 1)
+
+	// The images occupy their reserved workers and the shared one
+	for i := 0; i < 5; i++ {
+		s.Schedule(&testRequest{uri: "wails://wails/image.png"}, RequestClassImage)
+	}
+
+	// Scripts are processed by their own worker
+	for i := 0; i < 3; i++ {
+		s.Schedule(&testRequest{uri: "wails://wails/main.js"}, RequestClassScript)
+	}
+	for i := 0; i < 3; i++ {
+		select {
+		case uri := <-processed:
+			if uri != "wails://wails/main.js" {
+				t.Fatalf("%s has been processed", uri)
+			}
+		case <-time.After(5 * time.Second):
+			t.Fatal("the scripts have been delayed by the images")
+		}
+	}
+
+	close(release)
+	for i := 0; i < 5; i++ {
+		<-processed
+	}
+
+	// Wait for the workers to finish their bookkeeping
+	for {
+		s.mu.Lock()
+		idle := s.sharedBusy == 0 && s.classes[RequestClassImage].busy == 0 && s.classes[RequestClassScript].busy == 0
+		s.mu.Unlock()
+		if idle {
+			break
+		}
+		time.Sleep(time.Millisecond)
+	}
+
+	stats := s.Stats()
+	if stats[RequestClassImage].Requests != 5 || stats[RequestClassScript].Requests != 3 {
+		t.Errorf("unexpected stats %+v", stats)
+	}
+	if stats[RequestClassImage].MaxQueueTime == 0 {
+		t.Error("no queue time for the queued images")
+	}
+}
+
+func TestRequestSchedulerMediaFlood(t *testing.T) {
+	release := make(chan struct{})
+	processed := make(chan string, 100)
+	process := func(req webview.Request) {
+		uri, _ := req.URL()
+		if classifyRequest(uri, nil) == RequestClassMedia {
+			<-release
+		}
+		processed <- uri
+	}
+
+	var workers [numRequestClasses]int
+	workers[RequestClassImage] = 1
+	workers[RequestClassScript] = 1
+	workers[RequestClassMedia] = 2
+	s := newRequestScheduler(process, workers, 1)
+
+	// The media requests occupy their reserved workers, but not the shared one
+	for i := 0; i < 10; i++ {
+		s.Schedule(&testRequest{uri: "wails://wails/intro.mp4"}, RequestClassMedia)
+	}
+	s.mu.Lock()
+	busy, sharedBusy := s.classes[RequestClassMedia].busy, s.sharedBusy
+	s.mu.Unlock()
+	if busy != 2 || sharedBusy != 0 {
+		t.Fatalf("%d media workers and %d shared workers are busy", busy, sharedBusy)
+	}
+
+	// Images and scripts are processed while the media requests are stuck
+	for i := 0; i < 4; i++ {
+		s.Schedule(&testRequest{uri: "wails://wails/image.png"}, RequestClassImage)
+		s.Schedule(&testRequest{uri: "wails://wails/main.js"}, RequestClassScript)
+	}
+	for i := 0; i < 8; i++ {
+		select {
+		case uri := <-processed:
+			if uri == "wails://wails/intro.mp4" {
+				t.Fatal("a media request has been processed")
+			}
+		case <-time.After(5 * time.Second):
+			t.Fatal("the images and scripts have been delayed by the media requests")
+		}
+	}
+
+	close(release)
+	for i := 0; i < 10; i++ {
+		<-processed
+	}
+}
@@ -0,0 +1,203 @@
+package assetserver
+
+import (
+	"bytes"
+	"net/http"
+	"strings"
+)
+
+// maxPendingHTML is the size up to which an unfinished tag or comment before the `<head>` is held back. If it gets
+// larger the scripts are injected in front of it.
+const maxPendingHTML = 64 << 10
+
+// scriptInjector injects the script tags into an HTML document while it's written to the ResponseWriter. The scripts
+// are inserted right after the `<head>` start tag, or before the first other element if the document has no head. The
+// document is scanned only up to that point and everything else is passed through without buffering it.
+type scriptInjector struct {
+	http.ResponseWriter
+
+	// scripts are the rendered script tags, nil until the injector has been started
+	scripts []byte
+
+	// pending holds the start of a tag or comment that hasn't been completely written yet
+	pending  []byte
+	injected bool
+	err      error
+}
+
+// start enables the injection for the response, until then all writes are passed through
+func (s *scriptInjector) start(scripts []byte) {
+	s.scripts = scripts
+}
+
+func (s *scriptInjector) Write(buf []byte) (int, error) {
+	if s.scripts == nil || s.injected {
+		return s.ResponseWriter.Write(buf)
+	}
+	if s.err != nil {
+		return 0, s.err
+	}
+
+	data := buf
+	if len(s.pending) != 0 {
+		data = append(s.pending, buf...)
+		s.pending = s.pending[:0]
+	}
+
+	pos, insertAt, complete := scanForHead(data)
+	switch {
+	case insertAt >= 0:
+		s.inject(data[:insertAt], data[insertAt:])
+	case !complete && len(data)-pos > maxPendingHTML:
+		s.inject(data[:pos], data[pos:])
+	default:
+		s.write(data[:pos])
+		s.pending = append(s.pending, data[pos:]...)
+	}
+
+	if s.err != nil {
+		return 0, s.err
+	}
+	return len(buf), nil
+}
+
+// Flush flushes the underlying ResponseWriter, an unfinished tag before the `<head>` is held back until it's complete
+func (s *scriptInjector) Flush() {
+	if flusher, ok := s.ResponseWriter.(http.Flusher); ok {
+		flusher.Flush()
+	}
+}
+
+// Close finishes the document, the scripts are appended if no place for them has been found
+func (s *scriptInjector) Close() error {
+	if s.scripts != nil && !s.injected {
+		pending := s.pending
+		s.pending = nil
+		s.inject(nil, pending)
+	}
+	return s.err
+}
+
+func (s *scriptInjector) inject(before []byte, after []byte) {
+	s.injected = true
+	s.write(before)
+	s.write(s.scripts)
+	s.write(after)
+}
+
+func (s *scriptInjector) write(data []byte) {
+	if s.err != nil || len(data) == 0 {
+		return
+	}
+	_, s.err = s.ResponseWriter.Write(data)
+}
+
+// scanForHead scans the start of an HTML document for the place to inject the scripts. insertAt is the offset to inject
+// the scripts at or -1 if it hasn't been found yet. Then pos is the offset up to which the document has been scanned
+// and complete is false if the data ends within a tag or comment starting at pos.
+func scanForHead(data []byte) (pos int, insertAt int, complete bool) {
+	for pos < len(data) {
+		next := bytes.IndexByte(data[pos:], '<')
+		if next < 0 {
+			return len(data), -1, true
+		}
+		pos += next
+		rest := data[pos:]
+
+		var end int
+		switch {
+		case len(rest) < 4 && strings.HasPrefix("<!--", string(rest)):
+			// Might become a comment
+			return pos, -1, false
+		case hasPrefix(rest, "<!--"):
+			end = bytes.Index(rest[4:], []byte("-->"))
+			if end >= 0 {
+				end += 4 + 3
+			}
+		case hasPrefix(rest, "<!"), hasPrefix(rest, "<?"), hasPrefix(rest, "</"):
+			end = bytes.IndexByte(rest, '>')
+			if end >= 0 {
+				end++
+			}
+		default:
+			name, ok := tagName(rest[1:])
+			if !ok {
+				return pos, -1, false
+			}
+			if len(name) == 0 {
+				// Not a tag, like `a < b`
+				pos++
+				continue
+			}
+			if !equalFoldASCII(name, "html") && !equalFoldASCII(name, "head") {
+				return pos, pos, true
+			}
+
+			end = tagEnd(rest)
+			if end >= 0 && equalFoldASCII(name, "head") {
+				return pos + end, pos + end, true
+			}
+		}
+
+		if end < 0 {
+			return pos, -1, false
+		}
+		pos += end
+	}
+	return pos, -1, true
+}
+
+// tagName returns the name of the start tag whose name starts at data, the name is empty if it's not a tag. ok is
+// false if data ends within the name.
+func tagName(data []byte) (name []byte, ok bool) {
+	if len(data) == 0 {
+		return nil, false
+	}
+	if c := data[0] | 0x20; c < 'a' || c > 'z' {
+		return nil, true
+	}
+	for i, c := range data {
+		if isTagNameEnd(c) {
+			return data[:i], true
+		}
+	}
+	return nil, false
+}
+
+func isTagNameEnd(c byte) bool {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '/' || c == '>'
+}
+
+// tagEnd returns the offset after the `>` that closes the tag, -1 if data ends within the tag
+func tagEnd(data []byte) int {
+	var quote byte
+	for i, c := range data {
+		switch {
+		case quote != 0:
+			if c == quote {
+				quote = 0
+			}
+		case c == '"' || c == '\'':
+			quote = c
+		case c == '>':
+			return i + 1
+		}
+	}
+	return -1
+}
+
+func hasPrefix(data []byte, prefix string) bool {
+	return len(data) >= len(prefix) && string(data[:len(prefix)]) == prefix
+}
+
+func equalFoldASCII(name []byte, lower string) bool {
+	if len(name) != len(lower) {
+		return false
+	}
+	for i := range name {
+		if name[i]|0x20 != lower[i] {
+			return false
+		}
+	}
+	return true
+}
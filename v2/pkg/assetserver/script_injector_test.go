@@ -0,0 +1,136 @@
+package assetserver
+
+import (
+	"bytes"
+	"net/http"
+	"net/http/httptest"
+	"strings"
+	"testing"
+
+	"github.com/wailsapp/wails/v2/pkg/assetserver/webview"
+)
+
+func TestScriptInjector(t *testing.T) {
+	const scripts = "<script/>"
+
+	tests := []struct {
+		document string
+		want     string
+	}{
+		{"<html><head><title>a</title></head></html>", "<html><head><script/><title>a</title></head></html>"},
+		{"<!DOCTYPE html>\n<HTML lang=en>\n<HEAD data-x='a>b'>x", "<!DOCTYPE html>\n<HTML lang=en>\n<HEAD data-x='a>b'><script/>x"},
+		{"<!-- <head> --><head>", "<!-- <head> --><head><script/>"},
+		{"<html><header></header>", "<html><script/><header></header>"},
+		{"<html><body>a < b</body>", "<html><script/><body>a < b</body>"},
+		{"1 < 2 <head>", "1 < 2 <head><script/>"},
+		{"plain text", "plain text<script/>"},
+		{"<html><!-- unterminated", "<html><script/><!-- unterminated"},
+		{"", "<script/>"},
+	}
+
+	for _, tt := range tests {
+		// Every split of the document into two writes must give the same result
+		for split := 0; split <= len(tt.document); split++ {
+			rec := httptest.NewRecorder()
+			injector := &scriptInjector{ResponseWriter: rec}
+			injector.start([]byte(scripts))
+
+			for _, chunk := range []string{tt.document[:split], tt.document[split:]} {
+				if n, err := injector.Write([]byte(chunk)); err != nil || n != len(chunk) {
+					t.Fatalf("write %q: %d, %v", chunk, n, err)
+				}
+			}
+			if err := injector.Close(); err != nil {
+				t.Fatal(err)
+			}
+
+			if got := rec.Body.String(); got != tt.want {
+				t.Errorf("%q split at %d: got %q, want %q", tt.document, split, got, tt.want)
+				break
+			}
+		}
+	}
+}
+
+func TestStreamedScriptInjection(t *testing.T) {
+	rec := httptest.NewRecorder()
+	var flushed string
+	handler := http.HandlerFunc(func(rw http.ResponseWriter, req *http.Request) {
+		rw.Header().Set(HeaderContentType, "text/html; charset=utf-8")
+		rw.Write([]byte("<html><head><title>"))
+		rw.(http.Flusher).Flush()
+		flushed = rec.Body.String()
+		rw.Write([]byte("page</title></head><body></body></html>"))
+	})
+
+	server, err := NewAssetServerWithHandler(handler, "", false, nil, testRuntimeAssets{})
+	if err != nil {
+		t.Fatal(err)
+	}
+	server.ServeHTTP(rec, httptest.NewRequest(http.MethodGet, "/", nil))
+
+	if !rec.Flushed || !strings.HasPrefix(flushed, "<html><head><script") {
+		t.Errorf("the head has not been streamed: %q", flushed)
+	}
+	body := rec.Body.String()
+	if !strings.Contains(body, runtimeJSPath) || !strings.HasSuffix(body, "<title>page</title></head><body></body></html>") {
+		t.Errorf("unexpected document %q", body)
+	}
+	if _, cached := server.indexHTMLCache.get(indexHTMLKey([]byte("<html><head><title>page</title></head><body></body></html>"), nil)); cached {
+		t.Error("a streamed document has been cached")
+	}
+}
+
+// recordingResponseWriter is a webview.ResponseWriter that records the body and if it has been flushed
+type recordingResponseWriter struct {
+	discardResponseWriter
+	body    bytes.Buffer
+	flushed bool
+}
+
+func (rw *recordingResponseWriter) Write(buf []byte) (int, error) {
+	rw.discardResponseWriter.Write(buf)
+	return rw.body.Write(buf)
+}
+
+func (rw *recordingResponseWriter) Flush() { rw.flushed = true }
+
+func (rw *recordingResponseWriter) Finish() error { return nil }
+
+type recordingRequest struct {
+	*fakeRequest
+	rw *recordingResponseWriter
+}
+
+func (r recordingRequest) Response() webview.ResponseWriter { return r.rw }
+
+func TestStreamedScriptInjectionWebView(t *testing.T) {
+	rw := &recordingResponseWriter{discardResponseWriter: discardResponseWriter{header: http.Header{}}}
+	var flushed bool
+	var head string
+	handler := http.HandlerFunc(func(w http.ResponseWriter, req *http.Request) {
+		w.Header().Set(HeaderContentType, "text/html; charset=utf-8")
+		w.Write([]byte("<html><head><title>"))
+		w.(http.Flusher).Flush()
+		// The webview must have the head with the scripts while the handler is still rendering
+		flushed, head = rw.flushed, rw.body.String()
+		w.Write([]byte("page</title></head><body></body></html>"))
+	})
+
+	server, err := NewAssetServerWithHandler(handler, "", false, nil, testRuntimeAssets{})
+	if err != nil {
+		t.Fatal(err)
+	}
+	req := recordingRequest{newFakeRequest(http.MethodGet, "wails://wails/", webkitRequestHeader("document"), nil), rw}
+	server.processWebViewRequestInternal(req)
+
+	if !flushed || !strings.HasPrefix(head, "<html><head><script") || !strings.Contains(head, runtimeJSPath) {
+		t.Errorf("the head has not been streamed to the webview: flushed %v, %q", flushed, head)
+	}
+	if rw.code != http.StatusOK || rw.header.Get(HeaderContentType) != "text/html; charset=utf-8" {
+		t.Errorf("status %d, Content-Type %q", rw.code, rw.header.Get(HeaderContentType))
+	}
+	if body := rw.body.String(); !strings.HasSuffix(body, "<title>page</title></head><body></body></html>") {
+		t.Errorf("unexpected document %q", body)
+	}
+}
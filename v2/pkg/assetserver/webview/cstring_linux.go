@@ -0,0 +1,70 @@
+//go:build linux
+// +build linux
+
+package webview
+
+/*
+#include <stdlib.h>
+*/
+import "C"
+
+import (
+	"sync"
+	"unsafe"
+)
+
+const (
+	maxCachedCStrings   = 1024
+	maxCachedCStringLen = 128
+)
+
+// responseCStrings caches the C copies of response header names, status texts and MIME types, which repeat between
+// responses. Header values like Content-Length, ETag or Last-Modified mostly differ and would fill the cache with
+// strings that are never used again.
+var responseCStrings = cStringCache{strings: make(map[string]*C.char)}
+
+// cStringCache keeps C copies of short strings. The copies are never freed, once the cache holds maxCachedCStrings
+// strings it doesn't grow anymore.
+type cStringCache struct {
+	mu      sync.RWMutex
+	strings map[string]*C.char
+}
+
+// get returns the C string for s, it must be released with put
+func (c *cStringCache) get(s string) *C.char {
+	if len(s) > maxCachedCStringLen {
+		return C.CString(s)
+	}
+
+	c.mu.RLock()
+	cs, ok := c.strings[s]
+	c.mu.RUnlock()
+	if ok {
+		return cs
+	}
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if cs, ok := c.strings[s]; ok {
+		return cs
+	}
+	if len(c.strings) >= maxCachedCStrings {
+		return C.CString(s)
+	}
+	cs = C.CString(s)
+	c.strings[s] = cs
+	return cs
+}
+
+// put frees the C string for s if it hasn't been cached
+func (c *cStringCache) put(s string, cs *C.char) {
+	if len(s) <= maxCachedCStringLen {
+		c.mu.RLock()
+		cached := c.strings[s] == cs
+		c.mu.RUnlock()
+		if cached {
+			return
+		}
+	}
+	C.free(unsafe.Pointer(cs))
+}
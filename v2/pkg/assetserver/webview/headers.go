@@ -0,0 +1,121 @@
+package webview
+
+import (
+	"net/http"
+	"strings"
+	"sync"
+)
+
+// commonHeaderNames maps the names of common request headers, canonical and in lower case, to their canonical form.
+// They are used instead of allocating the name of every header of every request.
+var commonHeaderNames = map[string]string{}
+
+func init() {
+	for _, name := range []string{
+		"Accept", "Accept-Encoding", "Accept-Language", "Authorization", "Cache-Control", "Connection",
+		"Content-Length", "Content-Type", "Cookie", "Host", "If-Match", "If-Modified-Since", "If-None-Match",
+		"If-Range", "Origin", "Pragma", "Range", "Referer", "Sec-Fetch-Dest", "Sec-Fetch-Mode", "Sec-Fetch-Site",
+		"Upgrade-Insecure-Requests", "User-Agent", "X-Requested-With",
+	} {
+		commonHeaderNames[name] = name
+		commonHeaderNames[strings.ToLower(name)] = name
+	}
+}
+
+// canonicalHeaderName returns the canonical form of the header name, name may point to memory that is only valid
+// during the call
+func canonicalHeaderName(name string) string {
+	if canonical, ok := commonHeaderNames[name]; ok {
+		return canonical
+	}
+	return http.CanonicalHeaderKey(strings.Clone(name))
+}
+
+const (
+	maxInternedHeaderValues   = 512
+	maxInternedHeaderValueLen = 256
+)
+
+// headerValues interns the values of the internedHeaders, which repeat between requests
+var headerValues = stringInterner{maxEntries: maxInternedHeaderValues, maxLen: maxInternedHeaderValueLen}
+
+// internedHeaders are the request headers with few distinct values. The values of other headers like Cookie,
+// Authorization, Referer or Range are copied, they might be secrets or change with every request.
+var internedHeaders = map[string]bool{
+	"Accept":          true,
+	"Accept-Encoding": true,
+	"Accept-Language": true,
+	"Host":            true,
+	"Origin":          true,
+	"User-Agent":      true,
+}
+
+// isInternedHeader reports if the values of the header with the canonical name are interned
+func isInternedHeader(name string) bool {
+	return internedHeaders[name] || strings.HasPrefix(name, "Sec-Fetch-")
+}
+
+// stringInterner returns the same string for equal strings of at most maxLen bytes. It's cleared once it holds
+// maxEntries strings.
+type stringInterner struct {
+	mu         sync.Mutex
+	strings    map[string]string
+	maxEntries int
+	maxLen     int
+}
+
+// intern returns the interned copy of s, s may point to memory that is only valid during the call
+func (i *stringInterner) intern(s string) string {
+	if len(s) > i.maxLen {
+		return strings.Clone(s)
+	}
+
+	i.mu.Lock()
+	defer i.mu.Unlock()
+
+	if interned, ok := i.strings[s]; ok {
+		return interned
+	}
+
+	if i.strings == nil || len(i.strings) >= i.maxEntries {
+		i.strings = make(map[string]string, i.maxEntries)
+	}
+	interned := strings.Clone(s)
+	i.strings[interned] = interned
+	return interned
+}
+
+// headerBuilder builds a request header, all single values share one allocation
+type headerBuilder struct {
+	header http.Header
+	values []string
+}
+
+func newHeaderBuilder(count int) headerBuilder {
+	return headerBuilder{
+		header: make(http.Header, count),
+		values: make([]string, count),
+	}
+}
+
+// add adds the header, name and value may point to memory that is only valid during the call
+func (b *headerBuilder) add(name string, value string) {
+	key := canonicalHeaderName(name)
+	if isInternedHeader(key) {
+		value = headerValues.intern(value)
+	} else {
+		value = strings.Clone(value)
+	}
+
+	if values, ok := b.header[key]; ok {
+		b.header[key] = append(values, value)
+		return
+	}
+
+	if len(b.values) == 0 {
+		b.values = make([]string, 1)
+	}
+	b.values[0] = value
+	b.header[key] = b.values[:1:1]
+	b.values = b.values[1:]
+}
@@ -0,0 +1,113 @@
+package webview
+
+import (
+	"net/http"
+	"reflect"
+	"testing"
+	"unsafe"
+)
+
+// webkitHeaders are the headers of a script request sent by WebKit
+var webkitHeaders = [][2]string{
+	{"Accept", "*/*"},
+	{"Accept-Encoding", "gzip, deflate"},
+	{"Accept-Language", "en-US"},
+	{"Origin", "wails://wails"},
+	{"Referer", "wails://wails/"},
+	{"Sec-Fetch-Dest", "script"},
+	{"User-Agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/605.1.15 (KHTML, like Gecko)"},
+}
+
+func TestHeaderBuilder(t *testing.T) {
+	h := newHeaderBuilder(5)
+	h.add("accept", "*/*")
+	h.add("x-custom-header", "1")
+	h.add("X-Custom-Header", "2")
+	h.add("Cookie", "a=1")
+	h.add("Sec-Fetch-Dest", "image")
+
+	want := http.Header{
+		"Accept":          {"*/*"},
+		"X-Custom-Header": {"1", "2"},
+		"Cookie":          {"a=1"},
+		"Sec-Fetch-Dest":  {"image"},
+	}
+	if !reflect.DeepEqual(h.header, want) {
+		t.Errorf("got %v, want %v", h.header, want)
+	}
+
+	// Appending to a value must not overwrite the following header
+	h.header["Cookie"] = append(h.header["Cookie"], "b=2")
+	if got := h.header.Get("Sec-Fetch-Dest"); got != "image" {
+		t.Errorf("Sec-Fetch-Dest has been overwritten with %q", got)
+	}
+}
+
+func TestHeaderBuilderInterning(t *testing.T) {
+	h := newHeaderBuilder(4)
+	h.add("Accept-Encoding", "gzip, deflate, br")
+	h.add("Sec-Fetch-Mode", "no-cors")
+	h.add("Cookie", "session=secret")
+	h.add("Authorization", "Bearer secret")
+
+	headerValues.mu.Lock()
+	defer headerValues.mu.Unlock()
+	for _, value := range []string{"gzip, deflate, br", "no-cors"} {
+		if _, ok := headerValues.strings[value]; !ok {
+			t.Errorf("%q has not been interned", value)
+		}
+	}
+	for _, value := range []string{"session=secret", "Bearer secret"} {
+		if _, ok := headerValues.strings[value]; ok {
+			t.Errorf("%q has been interned", value)
+		}
+	}
+}
+
+func TestStringInterner(t *testing.T) {
+	i := stringInterner{maxEntries: 2, maxLen: 8}
+
+	buf := []byte("gzip")
+	interned := i.intern(unsafe.String(&buf[0], len(buf)))
+	copy(buf, "xxxx")
+	if interned != "gzip" {
+		t.Fatalf("interned string points to the buffer: %q", interned)
+	}
+	if again := i.intern("gzip"); unsafe.StringData(again) != unsafe.StringData(interned) {
+		t.Error("string has not been interned")
+	}
+
+	i.intern("a")
+	i.intern("b")
+	if len(i.strings) > 2 {
+		t.Errorf("interner holds %d strings", len(i.strings))
+	}
+	if long := i.intern("too long to be interned"); long != "too long to be interned" {
+		t.Errorf("got %q", long)
+	}
+}
+
+// BenchmarkRequestHeader reports the allocations for the header of a request, like it's read from the
+// SoupMessageHeaders
+func BenchmarkRequestHeader(b *testing.B) {
+	b.Run("http.Header.Add", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			h := http.Header{}
+			for _, kv := range webkitHeaders {
+				// C.GoString allocates both strings
+				h.Add(string([]byte(kv[0])), string([]byte(kv[1])))
+			}
+		}
+	})
+
+	b.Run("headerBuilder", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			h := newHeaderBuilder(len(webkitHeaders))
+			for _, kv := range webkitHeaders {
+				h.add(kv[0], kv[1])
+			}
+		}
+	})
+}
@@ -16,16 +16,25 @@ import "C"
 import (
 	"io"
 	"net/http"
+	"sync"
 	"unsafe"
 )
 
-// NewRequest creates as new WebViewRequest based on a pointer to an `WebKitURISchemeRequest`
+// NewRequest creates as new WebViewRequest based on a pointer to an `WebKitURISchemeRequest`.
+//
+// The requests are pooled and have no finalizer, the request must be closed exactly once and not be used afterwards.
 func NewRequest(webKitURISchemeRequest unsafe.Pointer) Request {
 	webkitReq := (*C.WebKitURISchemeRequest)(webKitURISchemeRequest)
 	C.g_object_ref(C.gpointer(webkitReq))
 
-	req := &request{req: webkitReq}
-	return newRequestFinalizer(req)
+	req := requestPool.Get().(*request)
+	req.req = webkitReq
+	req.rw.req = webkitReq
+	return req
+}
+
+var requestPool = sync.Pool{
+	New: func() any { return new(request) },
 }
 
 var _ Request = &request{}
@@ -35,7 +44,7 @@ type request struct {
 
 	header http.Header
 	body   io.ReadCloser
-	rw     *responseWriter
+	rw     responseWriter
 }
 
 func (r *request) URL() (string, error) {
@@ -66,20 +75,27 @@ func (r *request) Body() (io.ReadCloser, error) {
 }
 
 func (r *request) Response() ResponseWriter {
-	if r.rw != nil {
-		return r.rw
-	}
-
-	r.rw = &responseWriter{req: r.req}
-	return r.rw
+	return &r.rw
 }
 
+// Close finishes the response and puts the request back into the pool
 func (r *request) Close() error {
+	if r.req == nil {
+		return errRequestClosed
+	}
+
 	var err error
 	if r.body != nil {
 		err = r.body.Close()
 	}
-	r.Response().Finish()
+	r.rw.Finish()
 	C.g_object_unref(C.gpointer(r.req))
+
+	// The header map of the response has been copied by WebKit and is reused for the next response
+	header := r.rw.header
+	clear(header)
+	*r = request{}
+	r.rw.header = header
+	requestPool.Put(r)
 	return err
 }
@@ -13,6 +13,7 @@ const (
 var (
 	errRequestStopped   = errors.New("request has been stopped")
 	errResponseFinished = errors.New("response has been finished")
+	errRequestClosed    = errors.New("request has been closed")
 )
 
 // A ResponseWriter interface is used by an HTTP handler to
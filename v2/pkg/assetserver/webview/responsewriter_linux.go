@@ -12,18 +12,45 @@ package webview
 #include "webkit2/webkit2.h"
 #include "gio/gunixinputstream.h"
 
+extern void releasePinnedBody(guintptr handle);
+
+static void releaseBody(gpointer handle)
+{
+	releasePinnedBody((guintptr)handle);
+}
+
+// newBodyStream returns a stream that reads the body in place, release is called once GLib doesn't need it anymore
+static GInputStream *newBodyStream(void *body, gsize length, guintptr release)
+{
+	GBytes *bytes = g_bytes_new_with_free_func(body, length, releaseBody, (gpointer)release);
+	GInputStream *stream = g_memory_input_stream_new_from_bytes(bytes);
+	g_bytes_unref(bytes);
+	return stream;
+}
 */
 import "C"
 import (
 	"fmt"
 	"io"
+	"math"
 	"net/http"
 	"os"
+	"runtime"
+	"runtime/cgo"
 	"strconv"
+	"strings"
 	"syscall"
 	"unsafe"
 )
 
+// maxBufferedBody is the Content-Length up to which a body is buffered and handed to WebKit as a memory stream. Bodies
+// of an unknown or larger length and flushed responses are streamed through a pipe.
+const maxBufferedBody = 1 << 20
+
+// maxReadBody is the size up to which content of a known length is read into a single buffer by ReadFrom, like the
+// chunks of media files served by the AssetServer
+const maxReadBody = 16 << 20
+
 type responseWriter struct {
 	req *C.WebKitURISchemeRequest
 
@@ -31,6 +58,13 @@ type responseWriter struct {
 	wroteHeader bool
 	finished    bool
 
+	code          int
+	contentLength int64
+
+	// body buffers a response with a known Content-Length until it's finished, it's nil once the response is streamed
+	body      []byte
+	streaming bool
+
 	w    io.WriteCloser
 	wErr error
 }
@@ -51,6 +85,18 @@ func (rw *responseWriter) Write(buf []byte) (int, error) {
 	if rw.wErr != nil {
 		return 0, rw.wErr
 	}
+
+	if !rw.streaming {
+		if rw.buffered(int64(len(rw.body) + len(buf))) {
+			rw.body = append(rw.body, buf...)
+			return len(buf), nil
+		}
+
+		rw.stream()
+		if rw.wErr != nil {
+			return 0, rw.wErr
+		}
+	}
 	return rw.w.Write(buf)
 }
 
@@ -59,31 +105,37 @@ func (rw *responseWriter) WriteHeader(code int) {
 		return
 	}
 	rw.wroteHeader = true
+	rw.code = code
 
-	contentLength := int64(-1)
+	rw.contentLength = -1
 	if sLen := rw.Header().Get(HeaderContentLength); sLen != "" {
-		if pLen, _ := strconv.ParseInt(sLen, 10, 64); pLen > 0 {
-			contentLength = pLen
+		if pLen, err := strconv.ParseInt(sLen, 10, 64); err == nil && pLen >= 0 {
+			rw.contentLength = pLen
 		}
 	}
 
-	// We can't use os.Pipe here, because that returns files with a finalizer for closing the FD. But the control over the
-	// read FD is given to the InputStream and will be closed there.
-	// Furthermore we especially don't want to have the FD_CLOEXEC
-	rFD, w, err := pipe()
-	if err != nil {
-		rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to open pipe: %s", err))
-		return
+	// Other bodies switch to the pipe on their first write, until then they might still be read with ReadFrom
+	if rw.contentLength > 0 && rw.contentLength <= maxBufferedBody {
+		rw.body = make([]byte, 0, rw.contentLength)
 	}
-	rw.w = w
+}
 
-	stream := C.g_unix_input_stream_new(C.int(rFD), C.gboolean(1))
-	defer C.g_object_unref(C.gpointer(stream))
+// buffered reports if a body of the given size is buffered, which it is up to the Content-Length if that is known and
+// at most maxBufferedBody
+func (rw *responseWriter) buffered(size int64) bool {
+	return rw.contentLength >= 0 && rw.contentLength <= maxBufferedBody && size <= rw.contentLength
+}
 
-	if err := webkit_uri_scheme_request_finish(rw.req, code, rw.Header(), stream, contentLength); err != nil {
-		rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to finish request: %s", err))
+// Flush sends the headers and all data written so far, the rest of the response is streamed
+func (rw *responseWriter) Flush() {
+	if rw.finished {
 		return
 	}
+
+	rw.WriteHeader(http.StatusOK)
+	if !rw.streaming {
+		rw.stream()
+	}
 }
 
 func (rw *responseWriter) Finish() error {
@@ -95,12 +147,197 @@ func (rw *responseWriter) Finish() error {
 		return nil
 	}
 	rw.finished = true
-	if rw.w != nil {
-		rw.w.Close()
+	if rw.streaming {
+		if rw.w != nil {
+			rw.w.Close()
+		}
+		return nil
 	}
+
+	rw.finishWithBody()
 	return nil
 }
 
+// FinishWithBody finishes the request with the body instead of anything written before, WebKit reads it in place. The
+// body must not be modified afterwards.
+func (rw *responseWriter) FinishWithBody(body []byte) error {
+	if rw.finished || rw.streaming {
+		return errResponseFinished
+	}
+
+	rw.WriteHeader(http.StatusOK)
+	rw.finished = true
+	rw.body = body
+	rw.finishWithBody()
+	return rw.wErr
+}
+
+// ReadFrom is used by io.Copy and http.ServeContent. Content of the declared Content-Length is not written through the
+// pipe: large regions of files are memory mapped and other content up to maxReadBody is read into a single buffer,
+// WebKit then gets a seekable memory stream of it.
+func (rw *responseWriter) ReadFrom(r io.Reader) (int64, error) {
+	if rw.finished {
+		return 0, errResponseFinished
+	}
+	rw.WriteHeader(http.StatusOK)
+
+	limited, _ := r.(*io.LimitedReader)
+	if limited == nil || limited.N <= 0 || limited.N != rw.contentLength || rw.streaming || len(rw.body) != 0 || rw.wErr != nil {
+		return io.Copy(writerOnly{rw}, r)
+	}
+
+	if file, ok := limited.R.(*os.File); ok && rw.mapped(limited.N) {
+		if n, ok := rw.finishWithFile(file, limited.N); ok {
+			limited.N -= n
+			return n, nil
+		}
+	}
+
+	if limited.N > maxReadBody {
+		return io.Copy(writerOnly{rw}, r)
+	}
+
+	body := rw.body[:0]
+	if int64(cap(body)) < limited.N {
+		body = make([]byte, limited.N)
+	}
+	body = body[:limited.N]
+	n, err := io.ReadFull(limited.R, body)
+	limited.N -= int64(n)
+	if err != nil {
+		// WebKit must not get a body that is shorter than the Content-Length
+		if err == io.EOF {
+			err = io.ErrUnexpectedEOF
+		}
+		rw.finished = true
+		rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to read body: %w", err))
+		return int64(n), err
+	}
+	rw.body = body
+	return int64(n), nil
+}
+
+// mapped reports if a file region of the given length is memory mapped instead of read into a buffer: regions of audio
+// and video files larger than maxBufferedBody, and regions that are too large to be read. A mapping isn't worth its
+// setup for smaller regions, and reading a mapping crashes with SIGBUS if the file gets truncated in the meantime.
+func (rw *responseWriter) mapped(length int64) bool {
+	if length > maxReadBody {
+		return true
+	}
+	contentType := rw.Header().Get(HeaderContentType)
+	isMedia := strings.HasPrefix(contentType, "video/") || strings.HasPrefix(contentType, "audio/")
+	return isMedia && length > maxBufferedBody
+}
+
+// finishWithFile finishes the request with a memory map of the region of the file that starts at its current offset.
+// ok is false if the file can't be mapped or is shorter than length. The mapping is released once WebKit doesn't need it anymore, the file must
+// not be truncated until then.
+func (rw *responseWriter) finishWithFile(file *os.File, length int64) (n int64, ok bool) {
+	offset, err := file.Seek(0, io.SeekCurrent)
+	if err != nil {
+		return 0, false
+	}
+	stat, err := file.Stat()
+	if err != nil || !stat.Mode().IsRegular() {
+		return 0, false
+	}
+	// WebKit has been told the length, it must not get a shorter stream
+	if length > stat.Size()-offset || length > math.MaxInt-int64(os.Getpagesize()) {
+		return 0, false
+	}
+
+	// The offset of the mapping must be a multiple of the page size
+	mapOffset := offset &^ int64(os.Getpagesize()-1)
+	rawConn, err := file.SyscallConn()
+	if err != nil {
+		return 0, false
+	}
+	var data []byte
+	var mmapErr error
+	err = rawConn.Control(func(fd uintptr) {
+		data, mmapErr = syscall.Mmap(int(fd), mapOffset, int(offset-mapOffset+length), syscall.PROT_READ, syscall.MAP_SHARED)
+	})
+	if err != nil || mmapErr != nil {
+		return 0, false
+	}
+
+	if _, err := file.Seek(length, io.SeekCurrent); err != nil {
+		syscall.Munmap(data)
+		return 0, false
+	}
+
+	rw.finished = true
+	rw.finishWithMemory(unsafe.Pointer(&data[offset-mapOffset]), length, func() { syscall.Munmap(data) })
+	return length, true
+}
+
+// finishWithBody finishes the request with a memory stream that reads the buffered body without copying it
+func (rw *responseWriter) finishWithBody() {
+	body := rw.body
+	rw.body = nil
+
+	if len(body) == 0 {
+		stream := C.g_memory_input_stream_new()
+		defer C.g_object_unref(C.gpointer(stream))
+		if err := webkit_uri_scheme_request_finish(rw.req, rw.code, rw.Header(), stream, max(rw.contentLength, 0)); err != nil {
+			rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to finish request: %s", err))
+		}
+		return
+	}
+
+	// GLib reads the body in place, it stays pinned until the stream has been consumed or freed
+	pinner := new(runtime.Pinner)
+	pinner.Pin(&body[0])
+	rw.finishWithMemory(unsafe.Pointer(&body[0]), int64(len(body)), pinner.Unpin)
+}
+
+// finishWithMemory finishes the request with a seekable memory stream that reads the data in place, release is called
+// once GLib doesn't need the data anymore
+func (rw *responseWriter) finishWithMemory(data unsafe.Pointer, length int64, release func()) {
+	stream := C.newBodyStream(data, C.gsize(length), C.guintptr(cgo.NewHandle(release)))
+	defer C.g_object_unref(C.gpointer(stream))
+
+	contentLength := rw.contentLength
+	if contentLength < 0 {
+		contentLength = length
+	}
+	if err := webkit_uri_scheme_request_finish(rw.req, rw.code, rw.Header(), stream, contentLength); err != nil {
+		rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to finish request: %s", err))
+	}
+}
+
+// stream finishes the request with a pipe, the buffered body is written to the pipe and all following writes go
+// through it
+func (rw *responseWriter) stream() {
+	rw.streaming = true
+	body := rw.body
+	rw.body = nil
+
+	// We can't use os.Pipe here, because that returns files with a finalizer for closing the FD. But the control over the
+	// read FD is given to the InputStream and will be closed there.
+	// Furthermore we especially don't want to have the FD_CLOEXEC
+	rFD, w, err := pipe()
+	if err != nil {
+		rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to open pipe: %s", err))
+		return
+	}
+	rw.w = w
+
+	stream := C.g_unix_input_stream_new(C.int(rFD), C.gboolean(1))
+	defer C.g_object_unref(C.gpointer(stream))
+
+	if err := webkit_uri_scheme_request_finish(rw.req, rw.code, rw.Header(), stream, rw.contentLength); err != nil {
+		rw.finishWithError(http.StatusInternalServerError, fmt.Errorf("unable to finish request: %s", err))
+		return
+	}
+
+	if len(body) > 0 {
+		if _, err := rw.w.Write(body); err != nil {
+			rw.wErr = err
+		}
+	}
+}
+
 func (rw *responseWriter) finishWithError(code int, err error) {
 	if rw.w != nil {
 		rw.w.Close()
@@ -115,6 +352,11 @@ func (rw *responseWriter) finishWithError(code int, err error) {
 	C.free(unsafe.Pointer(msg))
 }
 
+// writerOnly hides the ReadFrom method of the responseWriter from io.Copy
+type writerOnly struct {
+	io.Writer
+}
+
 type nopCloser struct {
 	io.Writer
 }
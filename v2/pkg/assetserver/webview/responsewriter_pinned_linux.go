@@ -0,0 +1,24 @@
+//go:build linux
+// +build linux
+
+package webview
+
+/*
+#cgo linux pkg-config: glib-2.0
+
+#include "glib.h"
+*/
+import "C"
+import (
+	"runtime/cgo"
+)
+
+// releasePinnedBody releases the memory of a response body once GLib doesn't need it anymore, like unpinning a
+// buffered body or unmapping a file, see responseWriter.finishWithMemory
+//
+//export releasePinnedBody
+func releasePinnedBody(handle C.guintptr) {
+	h := cgo.Handle(handle)
+	h.Value().(func())()
+	h.Delete()
+}
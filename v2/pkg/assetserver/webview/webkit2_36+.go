@@ -10,6 +10,8 @@ package webview
 #include "gtk/gtk.h"
 #include "webkit2/webkit2.h"
 #include "libsoup/soup.h"
+#include <stdlib.h>
+#include <string.h>
 */
 import "C"
 
@@ -28,40 +30,54 @@ func webkit_uri_scheme_request_get_http_headers(req *C.WebKitURISchemeRequest) h
 	hdrs := C.webkit_uri_scheme_request_get_http_headers(req)
 
 	var iter C.SoupMessageHeadersIter
-	C.soup_message_headers_iter_init(&iter, hdrs)
-
 	var name *C.char
 	var value *C.char
 
-	h := http.Header{}
+	// Count the headers first, so the header and its values can be allocated at once
+	count := 0
+	C.soup_message_headers_iter_init(&iter, hdrs)
 	for C.soup_message_headers_iter_next(&iter, &name, &value) != 0 {
-		h.Add(C.GoString(name), C.GoString(value))
+		count++
 	}
 
-	return h
+	h := newHeaderBuilder(count)
+	C.soup_message_headers_iter_init(&iter, hdrs)
+	for C.soup_message_headers_iter_next(&iter, &name, &value) != 0 {
+		h.add(cStringView(name), cStringView(value))
+	}
+
+	return h.header
+}
+
+// cStringView returns a string that points to the C string, it's only valid as long as the C string is
+func cStringView(s *C.char) string {
+	return unsafe.String((*byte)(unsafe.Pointer(s)), int(C.strlen(s)))
 }
 
 func webkit_uri_scheme_request_finish(req *C.WebKitURISchemeRequest, code int, header http.Header, stream *C.GInputStream, streamLength int64) error {
 	resp := C.webkit_uri_scheme_response_new(stream, C.gint64(streamLength))
 	defer C.g_object_unref(C.gpointer(resp))
 
-	cReason := C.CString(http.StatusText(code))
+	reason := http.StatusText(code)
+	cReason := responseCStrings.get(reason)
 	C.webkit_uri_scheme_response_set_status(resp, C.guint(code), cReason)
-	C.free(unsafe.Pointer(cReason))
+	responseCStrings.put(reason, cReason)
 
-	cMimeType := C.CString(header.Get(HeaderContentType))
+	mimeType := header.Get(HeaderContentType)
+	cMimeType := responseCStrings.get(mimeType)
 	C.webkit_uri_scheme_response_set_content_type(resp, cMimeType)
-	C.free(unsafe.Pointer(cMimeType))
+	responseCStrings.put(mimeType, cMimeType)
 
 	hdrs := C.soup_message_headers_new(C.SOUP_MESSAGE_HEADERS_RESPONSE)
 	for name, values := range header {
-		cName := C.CString(name)
+		cName := responseCStrings.get(name)
 		for _, value := range values {
+			// Header values mostly differ between responses, see responseCStrings
 			cValue := C.CString(value)
 			C.soup_message_headers_append(hdrs, cName, cValue)
 			C.free(unsafe.Pointer(cValue))
 		}
-		C.free(unsafe.Pointer(cName))
+		responseCStrings.put(name, cName)
 	}
 
 	C.webkit_uri_scheme_response_set_http_headers(resp, hdrs)
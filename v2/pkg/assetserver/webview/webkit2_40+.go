@@ -10,6 +10,28 @@ package webview
 #include "gtk/gtk.h"
 #include "webkit2/webkit2.h"
 #include "gio/gunixinputstream.h"
+
+// streamLength returns the remaining length of a seekable stream or -1 if it's unknown
+static gint64 streamLength(GInputStream *stream)
+{
+	if (!G_IS_SEEKABLE(stream) || !g_seekable_can_seek(G_SEEKABLE(stream)))
+	{
+		return -1;
+	}
+
+	GSeekable *seekable = G_SEEKABLE(stream);
+	goffset pos = g_seekable_tell(seekable);
+	if (!g_seekable_seek(seekable, 0, G_SEEK_END, NULL, NULL))
+	{
+		return -1;
+	}
+	goffset end = g_seekable_tell(seekable);
+	if (!g_seekable_seek(seekable, pos, G_SEEK_SET, NULL, NULL))
+	{
+		return -1;
+	}
+	return end - pos;
+}
 */
 import "C"
 
@@ -17,9 +39,20 @@ import (
 	"fmt"
 	"io"
 	"net/http"
+	"sync"
 	"unsafe"
 )
 
+// bodyBufferSize is the size of the buffers WriteTo reads the request body into
+const bodyBufferSize = 64 << 10
+
+var bodyBufferPool = sync.Pool{
+	New: func() any {
+		buf := make([]byte, bodyBufferSize)
+		return &buf
+	},
+}
+
 func webkit_uri_scheme_request_get_http_body(req *C.WebKitURISchemeRequest) io.ReadCloser {
 	stream := C.webkit_uri_scheme_request_get_http_body(req)
 	if stream == nil {
@@ -33,23 +66,18 @@ type webkitRequestBody struct {
 	closed bool
 }
 
-// Read implements io.Reader
+// Read implements io.Reader, it returns the data that is available instead of waiting until p has been filled
 func (r *webkitRequestBody) Read(p []byte) (int, error) {
 	if r.closed {
 		return 0, io.ErrClosedPipe
 	}
-
-	var content unsafe.Pointer
-	var contentLen int
-	if p != nil {
-		content = unsafe.Pointer(&p[0])
-		contentLen = len(p)
+	if len(p) == 0 {
+		return 0, nil
 	}
 
-	var n C.gsize
 	var gErr *C.GError
-	res := C.g_input_stream_read_all(r.stream, content, C.gsize(contentLen), &n, nil, &gErr)
-	if res == 0 {
+	n := C.g_input_stream_read(r.stream, unsafe.Pointer(&p[0]), C.gsize(len(p)), nil, &gErr)
+	if n < 0 {
 		return 0, formatGError("stream read failed", gErr)
 	} else if n == 0 {
 		return 0, io.EOF
@@ -57,6 +85,40 @@ func (r *webkitRequestBody) Read(p []byte) (int, error) {
 	return int(n), nil
 }
 
+// WriteTo implements io.WriterTo, so io.Copy reads the body into pooled buffers instead of allocating one per request
+func (r *webkitRequestBody) WriteTo(w io.Writer) (int64, error) {
+	bufp := bodyBufferPool.Get().(*[]byte)
+	defer bodyBufferPool.Put(bufp)
+
+	var written int64
+	for {
+		n, err := r.Read(*bufp)
+		if n > 0 {
+			nw, werr := w.Write((*bufp)[:n])
+			written += int64(nw)
+			if werr != nil {
+				return written, werr
+			}
+			if nw != n {
+				return written, io.ErrShortWrite
+			}
+		}
+		if err == io.EOF {
+			return written, nil
+		} else if err != nil {
+			return written, err
+		}
+	}
+}
+
+// ContentLength returns the length of the body, or -1 if WebKit streams a body of unknown length
+func (r *webkitRequestBody) ContentLength() int64 {
+	if r.closed {
+		return -1
+	}
+	return int64(C.streamLength(r.stream))
+}
+
 func (r *webkitRequestBody) Close() error {
 	if r.closed {
 		return nil
@@ -14,7 +14,6 @@ import (
 	"fmt"
 	"io"
 	"net/http"
-	"unsafe"
 )
 
 const Webkit2MinMinorVersion = 0
@@ -41,8 +40,9 @@ func webkit_uri_scheme_request_finish(req *C.WebKitURISchemeRequest, code int, h
 		return fmt.Errorf("StatusCodes not supported: %d - %s", code, http.StatusText(code))
 	}
 
-	cMimeType := C.CString(header.Get(HeaderContentType))
+	mimeType := header.Get(HeaderContentType)
+	cMimeType := responseCStrings.get(mimeType)
 	C.webkit_uri_scheme_request_finish(req, stream, C.gint64(streamLength), cMimeType)
-	C.free(unsafe.Pointer(cMimeType))
+	responseCStrings.put(mimeType, cMimeType)
 	return nil
 }
@@ -58,6 +58,7 @@ type Options struct {
 	Verbosity         int                  // Verbosity level (0 - silent, 1 - default, 2 - verbose)
 	Compress          bool                 // Compress the final binary
 	CompressFlags     string               // Flags to pass to UPX
+	CompressAssets    bool                 // Write brotli and gzip variants of the embedded assets
 	WebView2Strategy  string               // WebView2 installer strategy
 	RunDelve          bool                 // Indicates if we should run delve after the build
 	WailsJSDir        string               // Directory to generate the wailsjs module
@@ -141,6 +142,10 @@ func Build(options *Options) (string, error) {
 
 	compileBinary := ""
 	if !options.IgnoreApplication {
+		if err := GenerateAssetManifests(cwd, options); err != nil {
+			return "", err
+		}
+
 		compileBinary, err = execBuildApplication(builder, options)
 		if err != nil {
 			return "", err
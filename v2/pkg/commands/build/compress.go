@@ -0,0 +1,157 @@
+package build
+
+import (
+	"bytes"
+	"compress/gzip"
+	"fmt"
+	"io/fs"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+
+	"github.com/pterm/pterm"
+	"github.com/wailsapp/wails/v2/internal/shell"
+)
+
+// minCompressSize is the size below which compressing an asset doesn't pay off
+const minCompressSize = 1024
+
+// compressibleExtensions are the extensions of assets that get precompressed, other formats like images and fonts
+// are compressed already
+var compressibleExtensions = map[string]bool{
+	".css":  true,
+	".html": true,
+	".js":   true,
+	".json": true,
+	".map":  true,
+	".mjs":  true,
+	".svg":  true,
+	".txt":  true,
+	".wasm": true,
+	".xml":  true,
+}
+
+// compressAssets writes gzip and brotli variants next to the compressible assets in dir and returns their paths,
+// relative to dir, for the asset manifest. Brotli variants need the `brotli` command. The variants are written on
+// every build, so they always belong to the current assets. Variants that aren't smaller than their asset are removed,
+// as well as the variants that a previous build left next to assets that aren't compressed anymore.
+func compressAssets(dir string, includeHidden bool, verbose bool) (map[string]bool, error) {
+	useBrotli := shell.CommandExists("brotli")
+	if !useBrotli {
+		pterm.Warning.Println("Warning: Cannot create brotli variants of the assets: brotli not found")
+	}
+
+	variants := map[string]bool{}
+	err := filepath.WalkDir(dir, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			return err
+		}
+		if path != dir && !includeHidden && (d.Name()[0] == '.' || d.Name()[0] == '_') {
+			if d.IsDir() {
+				return filepath.SkipDir
+			}
+			return nil
+		}
+		// index.html gets the runtime injected when it's served, so it can't be served precompressed
+		if d.IsDir() || d.Name() == "index.html" || !compressibleExtensions[strings.ToLower(filepath.Ext(path))] {
+			return nil
+		}
+
+		info, err := d.Info()
+		if err != nil {
+			return err
+		}
+		compress := info.Size() >= minCompressSize
+
+		for _, variant := range []struct {
+			ext      string
+			compress func(src, dst string) error
+			enabled  bool
+		}{
+			{".gz", gzipFile, compress},
+			{".br", brotliFile, compress && useBrotli},
+		} {
+			if !variant.enabled {
+				if err := removeVariant(path + variant.ext); err != nil {
+					return err
+				}
+				continue
+			}
+
+			written, err := compressAsset(path, info, variant.ext, variant.compress)
+			if err != nil {
+				return err
+			}
+			if written {
+				rel, err := filepath.Rel(dir, path+variant.ext)
+				if err != nil {
+					return err
+				}
+				variants[filepath.ToSlash(rel)] = true
+			}
+		}
+		if verbose && compress {
+			pterm.Info.Println("Compressed", path)
+		}
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	return variants, nil
+}
+
+// compressAsset writes the variant of the asset with the extension. written is false if the variant has been removed
+// because it isn't smaller than the asset.
+func compressAsset(path string, info fs.FileInfo, ext string, compress func(src, dst string) error) (written bool, err error) {
+	variant := path + ext
+	if err := compress(path, variant); err != nil {
+		return false, err
+	}
+
+	stat, err := os.Stat(variant)
+	if err != nil {
+		return false, err
+	}
+	if stat.Size() >= info.Size() {
+		return false, os.Remove(variant)
+	}
+	return true, nil
+}
+
+// removeVariant removes a variant that has been written by a previous build
+func removeVariant(variant string) error {
+	if err := os.Remove(variant); err != nil && !os.IsNotExist(err) {
+		return err
+	}
+	return nil
+}
+
+func gzipFile(src, dst string) error {
+	data, err := os.ReadFile(src)
+	if err != nil {
+		return err
+	}
+
+	var buf bytes.Buffer
+	w, err := gzip.NewWriterLevel(&buf, gzip.BestCompression)
+	if err != nil {
+		return err
+	}
+	if _, err := w.Write(data); err != nil {
+		return err
+	}
+	if err := w.Close(); err != nil {
+		return err
+	}
+	return os.WriteFile(dst, buf.Bytes(), 0o644)
+}
+
+func brotliFile(src, dst string) error {
+	output, err := exec.Command("brotli", "--best", "--force", "--output="+dst, src).CombinedOutput()
+	if err != nil {
+		return fmt.Errorf("brotli: %s: %w", strings.TrimSpace(string(output)), err)
+	}
+	return nil
+}
@@ -0,0 +1,80 @@
+package build
+
+import (
+	"errors"
+	"os"
+	"path/filepath"
+
+	"github.com/pterm/pterm"
+
+	"github.com/wailsapp/wails/v2/internal/staticanalysis"
+	"github.com/wailsapp/wails/v2/pkg/assetserver"
+)
+
+// GenerateAssetManifests writes the asset manifest into every embedded directory that contains an `index.html`. Dev
+// builds remove the manifests, the assets change while developing. With CompressAssets the compressible assets get
+// gzip and brotli variants first, which the manifest records. Precompressed files that haven't been written by the
+// build are not recorded, they might belong to an older version of their asset.
+func GenerateAssetManifests(cwd string, buildOptions *Options) error {
+	path := cwd
+	if buildOptions.ProjectData != nil {
+		path = buildOptions.ProjectData.Path
+	}
+	embedDetails, err := staticanalysis.GetEmbedDetails(path)
+	if err != nil {
+		return err
+	}
+
+	if buildOptions.Mode != Dev {
+		printBulletPoint("Generating asset manifest: ")
+	}
+
+	for _, embedDetail := range embedDetails {
+		fullPath := embedDetail.GetFullPath()
+		if stat, err := os.Stat(fullPath); err != nil || !stat.IsDir() {
+			continue
+		}
+
+		manifestPath := filepath.Join(fullPath, assetserver.ManifestFileName)
+		if buildOptions.Mode == Dev {
+			if err := os.Remove(manifestPath); err != nil && !os.IsNotExist(err) {
+				return err
+			}
+			continue
+		}
+
+		fsys := os.DirFS(fullPath)
+		if _, err := assetserver.FindPathToFile(fsys, "index.html"); errors.Is(err, os.ErrNotExist) {
+			// Not an asset directory
+			continue
+		} else if err != nil {
+			return err
+		}
+
+		var variants map[string]bool
+		if buildOptions.CompressAssets {
+			variants, err = compressAssets(fullPath, embedDetail.All, buildOptions.Verbosity == VERBOSE)
+			if err != nil {
+				return err
+			}
+		}
+
+		manifest, err := assetserver.BuildManifest(fsys, embedDetail.All, variants)
+		if err != nil {
+			return err
+		}
+
+		data, err := manifest.MarshalBinary()
+		if err != nil {
+			return err
+		}
+		if err := os.WriteFile(manifestPath, data, 0o644); err != nil {
+			return err
+		}
+	}
+
+	if buildOptions.Mode != Dev {
+		pterm.Println("Done.")
+	}
+	return nil
+}
@@ -1,5 +1,7 @@
 package linux
 
+import "context"
+
 // WebviewGpuPolicy values used for determining the webview's hardware acceleration policy.
 type WebviewGpuPolicy int
 
@@ -12,6 +14,34 @@ const (
 	WebviewGpuPolicyNever
 )
 
+// InboundQueuePolicy defines what happens when messages or requests from the webview arrive faster than they can be
+// processed and the inbound queue reaches its capacity. The main thread is never blocked.
+type InboundQueuePolicy int
+
+const (
+	// InboundQueueSpill keeps queueing into an unbounded buffer once the capacity has been reached.
+	InboundQueueSpill InboundQueuePolicy = iota
+	// InboundQueueDropOldest drops the oldest queued item that the new one supersedes, dropped items are handled like
+	// rejected items. An `EventsEmit` message supersedes the queued emits of the same event, so the Go listeners may
+	// miss intermediate events but get the latest one. If nothing is superseded, the new item spills.
+	InboundQueueDropOldest
+	// InboundQueueReject rejects new items once the capacity has been reached. Rejected calls fail in the frontend,
+	// rejected requests are answered with `503 Service Unavailable` and OnReject is called.
+	InboundQueueReject
+)
+
+// InboundQueueOptions configure a queue between the webview and the Go side
+type InboundQueueOptions struct {
+	// Capacity of the queue, defaults to 100
+	Capacity int
+
+	// Policy to apply once the capacity has been reached, defaults to InboundQueueSpill
+	Policy InboundQueuePolicy
+
+	// OnReject is called with an error for every item that has been rejected or dropped
+	OnReject func(err error)
+}
+
 // Options specific to Linux builds
 type Options struct {
 	// Icon Sets up the icon representing the window. This icon is used when the window is minimized
@@ -43,6 +73,23 @@ type Options struct {
 	//
 	//[see the docs]: https://docs.gtk.org/glib/func.set_prgname.html
 	ProgramName string
+
+	// OnBinaryMessage is called for every ArrayBuffer or TypedArray posted with `window.WailsInvokeBinary()` from
+	// the frontend. The message is handed over without copying and is only valid until the callback returns, so it
+	// must be copied if it needs to be retained. The callback runs on the main thread and should return quickly.
+	// Requires at least WebKit2GTK 2.38.
+	OnBinaryMessage func(ctx context.Context, message []byte)
+
+	// WindowEvents enables the `wails:window:geometry` (x, y, width, height) and `wails:window:state` ("normal",
+	// "maximised", "minimised" or "fullscreen") events, that are emitted after the main window moved, resized or
+	// changed its state.
+	WindowEvents bool
+
+	// MessageQueue configures the queue for IPC messages from the frontend
+	MessageQueue *InboundQueueOptions
+
+	// RequestQueue configures the queue for asset requests from the webview
+	RequestQueue *InboundQueueOptions
 }
 
 type Messages struct {
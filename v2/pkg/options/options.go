@@ -173,11 +173,15 @@ type SingleInstanceLock struct {
 	// uniqueId that will be used for setting up messaging between instances
 	UniqueId               string
 	OnSecondInstanceLaunch func(secondInstanceData SecondInstanceData)
+
+	// Data is passed to the first instance together with the arguments. Currently only supported on Linux.
+	Data []byte
 }
 
 type SecondInstanceData struct {
 	Args             []string
 	WorkingDirectory string
+	Data             []byte `json:",omitempty"`
 }
 
 func NewSecondInstanceData() (*SecondInstanceData, error) {
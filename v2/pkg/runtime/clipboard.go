@@ -1,6 +1,10 @@
 package runtime
 
-import "context"
+import (
+	"context"
+
+	"github.com/wailsapp/wails/v2/internal/frontend"
+)
 
 func ClipboardGetText(ctx context.Context) (string, error) {
 	appFrontend := getFrontend(ctx)
@@ -11,3 +15,42 @@ func ClipboardSetText(ctx context.Context, text string) error {
 	appFrontend := getFrontend(ctx)
 	return appFrontend.ClipboardSetText(text)
 }
+
+// ClipboardGetData returns the clipboard content of the given MIME type, e.g. `image/png`, or nil if the clipboard
+// has no content of that type. Currently only supported on Linux.
+func ClipboardGetData(ctx context.Context, mimeType string) ([]byte, error) {
+	clipboard, err := getClipboardData(ctx)
+	if err != nil {
+		return nil, err
+	}
+	return clipboard.ClipboardGetData(mimeType)
+}
+
+// ClipboardSetData puts the content, keyed by MIME type, on the clipboard. Currently only supported on Linux.
+func ClipboardSetData(ctx context.Context, data map[string][]byte) error {
+	mimeTypes := make([]string, 0, len(data))
+	for mimeType := range data {
+		mimeTypes = append(mimeTypes, mimeType)
+	}
+	return ClipboardSetDataLazy(ctx, mimeTypes, func(mimeType string) []byte {
+		return data[mimeType]
+	})
+}
+
+// ClipboardSetDataLazy offers the MIME types on the clipboard, provide is only called once a MIME type gets pasted.
+// provide is called on the main thread and should return quickly. Currently only supported on Linux.
+func ClipboardSetDataLazy(ctx context.Context, mimeTypes []string, provide func(mimeType string) []byte) error {
+	clipboard, err := getClipboardData(ctx)
+	if err != nil {
+		return err
+	}
+	return clipboard.ClipboardSetData(mimeTypes, provide)
+}
+
+func getClipboardData(ctx context.Context) (frontend.ClipboardData, error) {
+	clipboard, ok := getFrontend(ctx).(frontend.ClipboardData)
+	if !ok {
+		return nil, frontend.ErrClipboardDataNotSupported
+	}
+	return clipboard, nil
+}